@@ -0,0 +1,249 @@
+// Micro-benchmarks for the world and AI kernels, run against the shipped
+// map (when assets/eita.json is present; "eita_merged" is the same map
+// with its collision tiles merged, as the game loads it) and against
+// synthetic maps of increasing size and wall density:
+//
+//   ./build/GradeHeistBench --benchmark_filter=bfs
+//
+// Synthetic maps are named synthetic_<scale>x_<clutter>pct: the campus
+// footprint scaled by <scale> per axis, cut into 24-tile rooms with door
+// gaps. <clutter>% of the 6x6-tile blocks get a 3x3 piece of furniture in
+// their corner, which raises wall density while always leaving a lane
+// wide enough for the guard.
+#include <benchmark/benchmark.h>
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/Collision.h"
+#include "core/CollisionIndex.h"
+#include "core/Constants.h"
+#include "ui/isend.h"
+#include "world/CoarseGrid.h"
+#include "world/MapLoader.hpp"
+#include "world/Pathfinding.h"
+#include "world/VisibilityCaster.h"
+#include "world/WalkableGrid.h"
+
+namespace {
+
+const int ROOM = 24;        // synthetic room pitch in tiles
+const int DOOR = 4;         // door gap in tiles
+const int BLOCK = 6;        // furniture pitch in tiles; the piece fills half of it per axis
+const int QUERIES = 1024;   // precomputed inputs cycled by the query benchmarks
+
+struct BenchMap {
+    std::string name;
+    int worldW, worldH;
+    std::vector<sf::FloatRect> rects;
+
+    // Derived once, outside the timed loops
+    std::unique_ptr<CollisionIndex> index;
+    OccupancyGrid grid;
+    CoarseGrid coarse;
+    std::unique_ptr<VisibilityCaster> caster;
+    Tile pathStart;
+    Tile pathShort, pathMedium, pathCross;     // ~16 steps, ~64 steps, farthest reachable
+    std::vector<sf::Vector2f> openPoints;      // centres of open coarse cells
+
+    void prepare() {
+        index.reset(new CollisionIndex(rects, worldW, worldH, TILE_SIZE));
+        grid = buildWalkableGrid(rects, worldW, worldH, TILE_SIZE);
+        coarse = buildCoarseGrid(grid, TILE_SIZE, ENEMY_SIZE);
+        caster.reset(new VisibilityCaster(grid, TILE_SIZE, 4 * TILE_SIZE));
+        pickPathEnds();
+
+        std::mt19937 rng(7);
+        int k = coarse.footprint;
+        for (int tries = 0; tries < 100 * QUERIES && int(openPoints.size()) < QUERIES; ++tries) {
+            int x = int(rng() % coarse.cols), y = int(rng() % coarse.rows);
+            if (coarse.cells.test(x, y))
+                openPoints.emplace_back((x + k / 2) * TILE_SIZE + TILE_SIZE / 2.f,
+                                        (y + k / 2) * TILE_SIZE + TILE_SIZE / 2.f);
+        }
+        if (openPoints.empty()) openPoints.emplace_back(worldW / 2.f, worldH / 2.f);
+    }
+
+    // BFS from the open cell nearest the centre; path ends are picked by distance
+    void pickPathEnds() {
+        const OccupancyGrid& g = coarse.cells;
+        int cols = g.getCols(), rows = g.getRows();
+        long best = -1;
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
+                long d = long(x - cols / 2) * (x - cols / 2) + long(y - rows / 2) * (y - rows / 2);
+                if (g.test(x, y) && (best < 0 || d < best)) {
+                    best = d;
+                    pathStart = Tile(x, y);
+                }
+            }
+        }
+
+        std::vector<int> dist(size_t(cols) * rows, -1);
+        std::deque<Tile> q{pathStart};
+        dist[pathStart.second * cols + pathStart.first] = 0;
+        pathShort = pathMedium = pathCross = pathStart;
+        static const int DX[4] = {1, -1, 0, 0}, DY[4] = {0, 0, 1, -1};
+        while (!q.empty()) {
+            Tile t = q.front();
+            q.pop_front();
+            int d = dist[t.second * cols + t.first];
+            if (d <= 16) pathShort = t;
+            if (d <= 64) pathMedium = t;
+            pathCross = t;
+            for (int i = 0; i < 4; ++i) {
+                int nx = t.first + DX[i], ny = t.second + DY[i];
+                if (!g.test(nx, ny) || dist[ny * cols + nx] >= 0) continue;
+                dist[ny * cols + nx] = d + 1;
+                q.emplace_back(nx, ny);
+            }
+        }
+    }
+};
+
+std::unique_ptr<BenchMap> syntheticMap(int scale, int clutterPct) {
+    std::unique_ptr<BenchMap> m(new BenchMap);
+    m->name = "synthetic_" + std::to_string(scale) + "x_" + std::to_string(clutterPct) + "pct";
+    m->worldW = WORLD_W * scale;
+    m->worldH = WORLD_H * scale;
+
+    int cols = m->worldW / TILE_SIZE, rows = m->worldH / TILE_SIZE;
+    std::mt19937 rng(1234 + scale * 100 + clutterPct);
+    std::vector<char> furnished(size_t(cols / BLOCK + 1) * (rows / BLOCK + 1));
+    for (auto& f : furnished) f = int(rng() % 100) < clutterPct;
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            bool wallX = x % ROOM == 0 && (y % ROOM) < ROOM - DOOR;
+            bool wallY = y % ROOM == 0 && (x % ROOM) < ROOM - DOOR;
+            bool border = x == 0 || y == 0 || x == cols - 1 || y == rows - 1;
+            bool clutter = x % BLOCK < BLOCK / 2 && y % BLOCK < BLOCK / 2 &&
+                           furnished[(y / BLOCK) * (cols / BLOCK + 1) + x / BLOCK];
+            if (wallX || wallY || border || clutter)
+                m->rects.emplace_back(float(x * TILE_SIZE), float(y * TILE_SIZE), float(TILE_SIZE), float(TILE_SIZE));
+        }
+    }
+    m->prepare();
+    return m;
+}
+
+// mergeWalls: the game's merged collision rects instead of one per tile
+std::unique_ptr<BenchMap> shippedMap(bool mergeWalls) {
+    MapLoader loader("assets/eita.json", "", TILE_SIZE, TILE_SIZE);
+    if (!loader.load(false)) return nullptr;
+    if (mergeWalls) loader.mergeCollisionRects();
+    std::unique_ptr<BenchMap> m(new BenchMap);
+    m->name = mergeWalls ? "eita_merged" : "eita";
+    m->worldW = WORLD_W;
+    m->worldH = WORLD_H;
+    m->rects = loader.getCollisionRects();
+    m->prepare();
+    return m;
+}
+
+void BM_WalkableGrid(benchmark::State& state, const BenchMap* m) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(buildWalkableGrid(m->rects, m->worldW, m->worldH, TILE_SIZE));
+    state.SetItemsProcessed(state.iterations() * int64_t(m->rects.size()));
+}
+
+void BM_CoarseGrid(benchmark::State& state, const BenchMap* m) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(buildCoarseGrid(m->grid, TILE_SIZE, ENEMY_SIZE));
+}
+
+void BM_PathBFS(benchmark::State& state, const BenchMap* m, Tile goal) {
+    size_t length = 0;
+    for (auto _ : state) {
+        auto path = findPathBFS(m->pathStart, goal, m->coarse.cells);
+        length = path.size();
+        benchmark::DoNotOptimize(path.data());
+    }
+    state.counters["path_len"] = double(length);
+}
+
+void BM_CheckCollision(benchmark::State& state, const BenchMap* m) {
+    // Player-sized boxes around open cells, nudged so some touch walls
+    std::vector<sf::FloatRect> boxes;
+    std::mt19937 rng(11);
+    for (auto& p : m->openPoints)
+        boxes.emplace_back(p.x - 22.f + float(rng() % 24), p.y - 28.f + float(rng() % 24), 44.6f, 55.9f);
+    size_t i = 0, hits = 0;
+    for (auto _ : state) {
+        hits += checkCollision(boxes[i], *m->index);
+        i = (i + 1) % boxes.size();
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Isend(benchmark::State& state, const BenchMap* m) {
+    // Enemy at an open cell, player up to LIGHT_RADIUS away in a random
+    // direction. The light is cast once per tick by GameSim, so it is cast
+    // here outside the loop; light_polygon times it.
+    std::vector<std::pair<VisibilityPolygon, sf::Vector2f>> pairs;
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> angle(0.f, 6.2831853f), radius(0.f, LIGHT_RADIUS);
+    for (auto& p : m->openPoints) {
+        float a = angle(rng), r = radius(rng);
+        pairs.emplace_back(m->caster->visibility(p, LIGHT_RADIUS),
+                           p + sf::Vector2f(std::cos(a) * r, std::sin(a) * r));
+    }
+    size_t i = 0, caught = 0;
+    for (auto _ : state) {
+        caught += isend(m->grid, pairs[i].first, pairs[i].second);
+        i = (i + 1) % pairs.size();
+    }
+    benchmark::DoNotOptimize(caught);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The guard light drawn each frame by drawScene
+void BM_LightPolygon(benchmark::State& state, const BenchMap* m) {
+    size_t i = 0, points = 0;
+    for (auto _ : state) {
+        VisibilityPolygon light = m->caster->visibility(m->openPoints[i], LIGHT_RADIUS);
+        points += light.points.size();
+        i = (i + 1) % m->openPoints.size();
+    }
+    state.counters["points"] = benchmark::Counter(double(points), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void registerMap(const BenchMap* m) {
+    auto reg = [&](const char* kernel, auto fn) {
+        return benchmark::RegisterBenchmark((std::string(kernel) + "/" + m->name).c_str(), fn);
+    };
+    reg("walkable_grid", [m](benchmark::State& s) { BM_WalkableGrid(s, m); })->Unit(benchmark::kMillisecond);
+    reg("coarse_grid", [m](benchmark::State& s) { BM_CoarseGrid(s, m); })->Unit(benchmark::kMillisecond);
+    reg("bfs_short", [m](benchmark::State& s) { BM_PathBFS(s, m, m->pathShort); })->Unit(benchmark::kMicrosecond);
+    reg("bfs_medium", [m](benchmark::State& s) { BM_PathBFS(s, m, m->pathMedium); })->Unit(benchmark::kMicrosecond);
+    reg("bfs_cross", [m](benchmark::State& s) { BM_PathBFS(s, m, m->pathCross); })->Unit(benchmark::kMicrosecond);
+    reg("check_collision", [m](benchmark::State& s) { BM_CheckCollision(s, m); });
+    reg("isend", [m](benchmark::State& s) { BM_Isend(s, m); });
+    reg("light_polygon", [m](benchmark::State& s) { BM_LightPolygon(s, m); })->Unit(benchmark::kMicrosecond);
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::unique_ptr<BenchMap>> maps;
+    for (bool merged : {false, true})
+        if (auto shipped = shippedMap(merged)) maps.push_back(std::move(shipped));
+    for (int scale : {1, 2, 4})
+        for (int clutter : {0, 25, 50})
+            maps.push_back(syntheticMap(scale, clutter));
+
+    for (auto& m : maps) registerMap(m.get());
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
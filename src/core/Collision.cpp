@@ -1,8 +1,5 @@
 #include "core/Collision.h"
 
-bool checkCollision(const sf::FloatRect& b, const std::vector<sf::RectangleShape>& walls) {
-    for (auto& w : walls)
-        if (b.intersects(w.getGlobalBounds()))
-            return true;
-    return false;
+bool checkCollision(const sf::FloatRect& b, const CollisionIndex& walls) {
+    return walls.intersects(b);
 }
@@ -1,5 +1,5 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <vector>
+#include "core/CollisionIndex.h"
 
-bool checkCollision(const sf::FloatRect& b, const std::vector<sf::RectangleShape>& walls);
+bool checkCollision(const sf::FloatRect& b, const CollisionIndex& walls);
@@ -0,0 +1,56 @@
+#include "core/CollisionIndex.h"
+#include <algorithm>
+#include <cmath>
+
+CollisionIndex::CollisionIndex(const std::vector<sf::FloatRect>& R, int worldW, int worldH, int cs)
+    : cellSize(cs), cols(std::max(1, worldW / cs)), rows(std::max(1, worldH / cs)), rects(R)
+{
+    // Pass 1: count entries per cell, pass 2: scatter ids into place
+    cellStart.assign(cols * rows + 1, 0);
+    for (auto& r : rects) {
+        int x0, y0, x1, y1;
+        cellRange(r, x0, y0, x1, y1);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                ++cellStart[y * cols + x + 1];
+    }
+    for (size_t i = 1; i < cellStart.size(); ++i)
+        cellStart[i] += cellStart[i - 1];
+
+    cellItems.resize(cellStart.back());
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int id = 0; id < int(rects.size()); ++id) {
+        int x0, y0, x1, y1;
+        cellRange(rects[id], x0, y0, x1, y1);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                cellItems[fill[y * cols + x]++] = id;
+    }
+}
+
+bool CollisionIndex::intersects(const sf::FloatRect& b) const {
+    int x0, y0, x1, y1;
+    cellRange(b, x0, y0, x1, y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            int c = y * cols + x;
+            for (int i = cellStart[c]; i < cellStart[c + 1]; ++i)
+                if (b.intersects(rects[cellItems[i]]))
+                    return true;
+        }
+    }
+    return false;
+}
+
+const std::vector<sf::FloatRect>& CollisionIndex::getRects() const {
+    return rects;
+}
+
+// Cells covered by b, clamped to the grid so out-of-world boxes still
+// land in the border cells (clamping is monotonic, so no overlap is lost)
+void CollisionIndex::cellRange(const sf::FloatRect& b, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = std::clamp(int(std::floor(b.left / cellSize)), 0, cols - 1);
+    y0 = std::clamp(int(std::floor(b.top / cellSize)), 0, rows - 1);
+    x1 = std::clamp(int(std::floor((b.left + b.width) / cellSize)), 0, cols - 1);
+    y1 = std::clamp(int(std::floor((b.top + b.height) / cellSize)), 0, rows - 1);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Uniform-grid spatial index over static collision rects.
+// Every rect is bucketed into each cell it overlaps, so a query only
+// visits the few cells under the query box instead of every wall.
+class CollisionIndex {
+public:
+    CollisionIndex(const std::vector<sf::FloatRect>& rects, int worldW, int worldH, int cellSize);
+
+    // True if b overlaps any indexed rect (same test as sf::FloatRect::intersects)
+    bool intersects(const sf::FloatRect& b) const;
+
+    const std::vector<sf::FloatRect>& getRects() const;
+
+private:
+    int cellSize;
+    int cols, rows;
+    std::vector<sf::FloatRect> rects;
+
+    // Bucket contents in CSR layout: rect ids of cell i live in
+    // cellItems[cellStart[i] .. cellStart[i+1])
+    std::vector<int> cellStart;
+    std::vector<int> cellItems;
+
+    void cellRange(const sf::FloatRect& b, int& x0, int& y0, int& x1, int& y1) const;
+};
@@ -0,0 +1,78 @@
+#include "core/Profiler.h"
+#include <chrono>
+#include <fstream>
+
+static uint64_t steadyNs() {
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Profiler& Profiler::get() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler()
+    : ring(CAPACITY), epoch(steadyNs())
+{
+}
+
+void Profiler::newFrame() {
+    ++frame;
+}
+
+uint32_t Profiler::getFrame() const {
+    return frame;
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t duration, uint32_t d) {
+    ring[head] = {name, start, duration, frame, d};
+    head = (head + 1) % CAPACITY;
+    if (count < CAPACITY) ++count;
+}
+
+void Profiler::collect(uint32_t f, std::vector<Sample>& out) const {
+    out.clear();
+    // Walk back from the newest sample until frames older than f
+    for (size_t i = 0; i < count; ++i) {
+        const Sample& s = ring[(head + CAPACITY - 1 - i) % CAPACITY];
+        if (s.frame < f) break;
+        if (s.frame == f && s.depth == 0) out.push_back(s);
+    }
+    // Zones are recorded when they close, so reverse recording order is
+    // reverse start order for the non-overlapping depth-0 stages
+    std::vector<Sample>(out.rbegin(), out.rend()).swap(out);
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    size_t first = (head + CAPACITY - count) % CAPACITY;
+    for (size_t i = 0; i < count; ++i) {
+        const Sample& s = ring[(first + i) % CAPACITY];
+        // Complete ("X") events; times are in microseconds
+        out << (i ? ",\n" : "")
+            << "{\"name\":\"" << s.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+            << ",\"ts\":" << s.start / 1000.0 << ",\"dur\":" << s.duration / 1000.0
+            << ",\"args\":{\"frame\":" << s.frame << "}}";
+    }
+    out << "\n]}\n";
+    return bool(out);
+}
+
+uint64_t Profiler::now() const {
+    return steadyNs() - epoch;
+}
+
+ProfileScope::ProfileScope(const char* n)
+    : name(n), start(Profiler::get().now())
+{
+    ++Profiler::get().depth;
+}
+
+ProfileScope::~ProfileScope() {
+    Profiler& p = Profiler::get();
+    --p.depth;
+    p.record(name, start, p.now() - start, p.depth);
+}
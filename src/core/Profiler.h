@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame profiler for the main thread. Timed zones are written into a
+// fixed ring buffer, so recording never allocates and old frames simply
+// fall out. Zones nest; depth 0 zones are the stages of a frame.
+class Profiler {
+public:
+    struct Sample {
+        const char* name;       // string literal, never copied
+        uint64_t start;         // ns since the profiler was created
+        uint64_t duration;      // ns
+        uint32_t frame;
+        uint32_t depth;
+    };
+
+    static constexpr size_t CAPACITY = 1 << 14;
+
+    static Profiler& get();
+
+    // Marks the start of a new frame; zones recorded from now belong to it
+    void newFrame();
+    uint32_t getFrame() const;
+
+    void record(const char* name, uint64_t start, uint64_t duration, uint32_t depth);
+
+    // Depth-0 samples of frame f still in the buffer, in start order
+    void collect(uint32_t f, std::vector<Sample>& out) const;
+
+    // Everything in the buffer as Chrome trace events (chrome://tracing, Perfetto)
+    bool writeChromeTrace(const std::string& path) const;
+
+    uint64_t now() const;
+
+    // Nesting level of the zone being timed, kept by ProfileScope
+    uint32_t depth = 0;
+
+private:
+    Profiler();
+
+    std::vector<Sample> ring;
+    size_t head = 0;        // next slot to write
+    size_t count = 0;
+    uint32_t frame = 0;
+    uint64_t epoch;         // steady_clock ns at construction
+};
+
+// Times the enclosing block as one zone
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
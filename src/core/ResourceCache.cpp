@@ -0,0 +1,37 @@
+#include "core/ResourceCache.h"
+#include <iostream>
+
+template <class T>
+static std::shared_ptr<const T> acquire(std::unordered_map<std::string, std::weak_ptr<const T>>& cache,
+                                        const std::string& path, bool* loaded)
+{
+    auto it = cache.find(path);
+    if (it != cache.end()) {
+        if (std::shared_ptr<const T> alive = it->second.lock()) {
+            if (loaded) *loaded = true;
+            return alive;
+        }
+    }
+
+    auto resource = std::make_shared<T>();
+    bool ok = resource->loadFromFile(path);
+    if (loaded) *loaded = ok;
+    if (!ok) {
+        std::cerr << "Failed to load " << path << "\n";
+        return resource;
+    }
+    cache[path] = resource;
+    return resource;
+}
+
+std::shared_ptr<const sf::Font> ResourceCache::font(const std::string& path, bool* loaded) {
+    return acquire(fonts, path, loaded);
+}
+
+std::shared_ptr<const sf::Texture> ResourceCache::texture(const std::string& path, bool* loaded) {
+    return acquire(textures, path, loaded);
+}
+
+std::shared_ptr<const sf::SoundBuffer> ResourceCache::soundBuffer(const std::string& path, bool* loaded) {
+    return acquire(soundBuffers, path, loaded);
+}
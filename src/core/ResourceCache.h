@@ -0,0 +1,25 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Fonts, textures and sound buffers loaded once per path and shared. A
+// handle is a reference count: the resource lives while anyone holds one,
+// and asking again after the last is gone loads it afresh.
+//
+// A failed load prints an error and hands back an empty resource, as a
+// plain loadFromFile on a member would have left it; pass `loaded` to
+// find out. Failures are not cached.
+class ResourceCache {
+public:
+    std::shared_ptr<const sf::Font> font(const std::string& path, bool* loaded = nullptr);
+    std::shared_ptr<const sf::Texture> texture(const std::string& path, bool* loaded = nullptr);
+    std::shared_ptr<const sf::SoundBuffer> soundBuffer(const std::string& path, bool* loaded = nullptr);
+
+private:
+    std::unordered_map<std::string, std::weak_ptr<const sf::Font>> fonts;
+    std::unordered_map<std::string, std::weak_ptr<const sf::Texture>> textures;
+    std::unordered_map<std::string, std::weak_ptr<const sf::SoundBuffer>> soundBuffers;
+};
@@ -3,11 +3,9 @@
 #include <cmath>
 #include <algorithm>
 
-Enemy::Enemy(const std::vector<sf::RectangleShape>& W,
-             const std::vector<bool>& G,
-             int colsC, int rowsC,
+Enemy::Enemy(const OccupancyGrid& G,
              const std::vector<Tile>& patrolT)
-    : walls(W), coarseGrid(G), colsCoarse(colsC), rowsCoarse(rowsC), patrolTiles(patrolT)
+    : coarseGrid(G), patrolTiles(patrolT)
 {
     spr.setSize({ENEMY_SIZE, ENEMY_SIZE});
     spr.setOrigin(ENEMY_SIZE/2.f, ENEMY_SIZE/2.f);
@@ -23,15 +21,41 @@ Enemy::Enemy(const std::vector<sf::RectangleShape>& W,
 
 sf::RectangleShape& Enemy::shape() { return spr; }
 
+sf::Vector2f Enemy::getPosition() const { return spr.getPosition(); }
+
 void Enemy::setChasing(bool c) {
     if (chasing != c) {
         chasing = c;
+        chasePlanner.reset();
+        path.clear();
+        chaseTarget = Tile(-1, -1);
+        pi = 0;
+        moving = false;
+    }
+}
+
+void Enemy::setPathMode(PathMode mode) {
+    if (pathMode != mode) {
+        pathMode = mode;
         path.clear();
+        chaseTarget = Tile(-1, -1);
         pi = 0;
         moving = false;
     }
 }
 
+void Enemy::setPatrolRoutes(PatrolRouteCache* routes) {
+    patrolRoutes = routes;
+}
+
+void Enemy::setHierarchy(HPAStar* hpa) {
+    hierarchy = hpa;
+}
+
+void Enemy::setFlowField(FlowField* field) {
+    flowField = field;
+}
+
 // Call with playerTile = (cx,cy) of player in coarse grid
 void Enemy::update(Tile playerTile, float dt) {
     int k = ENEMY_SIZE / TILE_SIZE;
@@ -40,16 +64,44 @@ void Enemy::update(Tile playerTile, float dt) {
         int((spr.getPosition().y / TILE_SIZE) - (k/2))
     );
 
-    if (chasing) {
-        if (path.empty() || pi >= path.size()) {
-            path = findPathBFS(currentTile, playerTile, coarseGrid, colsCoarse, rowsCoarse);
+    if (chasing && pathMode == PathMode::Incremental) {
+        // Replans only repair the kept search tree, so refresh the route
+        // whenever the player changes tile, even halfway through a step
+        if (playerTile != chaseTarget) {
+            chaseTarget = playerTile;
+            if (moving) {
+                path = chasePlanner.plan(tileTo, playerTile, coarseGrid);
+                if (path.empty()) path.push_back(tileTo);
+                path.insert(path.begin(), tileFrom);
+            } else {
+                path = chasePlanner.plan(currentTile, playerTile, coarseGrid);
+            }
+            pi = 0;
+        }
+    } else if (chasing && pathMode == PathMode::FlowField && flowField) {
+        // One step at a time down the shared field
+        if (!moving) {
+            flowField->setTarget(playerTile);
+            Tile next = flowField->nextStep(currentTile);
+            path.clear();
+            if (next != currentTile) path = {currentTile, next};
+            pi = 0;
+        }
+    } else if (chasing) {
+        // Replan once the path is used up; partial hierarchical paths end early
+        if (path.empty() || pi + 1 >= path.size()) {
+            path = plan(currentTile, playerTile);
             pi = 0;
             moving = false;
         }
     } else {
         if (path.empty() || pi >= path.size()) {
             Tile patrolTarget = patrolTiles[(currentPatrolIndex + 1) % patrolTiles.size()];
-            path = findPathBFS(currentTile, patrolTarget, coarseGrid, colsCoarse, rowsCoarse);
+            // On the circuit the leg is already known; after a chase, plan back to it
+            if (patrolRoutes && currentTile == patrolTiles[currentPatrolIndex])
+                path = patrolRoutes->leg(currentPatrolIndex);
+            else
+                path = plan(currentTile, patrolTarget);
             pi = 0;
             moving = false;
         }
@@ -87,4 +139,26 @@ sf::Vector2f Enemy::tileCenter(Tile tile) const {
         (tile.first + k / 2) * TILE_SIZE + TILE_SIZE / 2.f,
         (tile.second + k / 2) * TILE_SIZE + TILE_SIZE / 2.f
     );
-}
\ No newline at end of file
+}
+
+std::vector<Tile> Enemy::plan(Tile from, Tile to) {
+    switch (pathMode) {
+        case PathMode::BFS: return findPathBFS(from, to, coarseGrid);
+        case PathMode::JPS: return jps.findPath(from, to, coarseGrid);
+        case PathMode::Hierarchical:
+            if (hierarchy) {
+                // While chasing only the way into the next cluster is refined;
+                // the rest is replanned against the player's new tile
+                auto route = hierarchy->findAbstractPath(from, to);
+                return hierarchy->refine(route, chasing ? 2 : route.size());
+            }
+            break;
+        case PathMode::Incremental:
+            // Patrol returns are the long queries, so answer them on the cluster graph
+            if (hierarchy) return hierarchy->findPath(from, to);
+            break;
+        case PathMode::AStar:
+        case PathMode::FlowField: break;
+    }
+    return search.findPath(from, to, coarseGrid);
+}
@@ -4,28 +4,58 @@
 #include <vector>
 #include <utility>
 #include "core/Constants.h"
+#include "world/OccupancyGrid.h"
+#include "world/AStar.h"
+#include "world/JumpPointSearch.h"
+#include "world/IncrementalPlanner.h"
+#include "world/HPAStar.h"
+#include "world/FlowField.h"
+#include "world/PatrolRouteCache.h"
 
 using Tile = std::pair<int, int>;
 
+// Planner used for chase paths and for walking back to the patrol circuit.
+// Legs along the circuit come from PatrolRouteCache, which always uses A*.
+enum class PathMode {
+    BFS,
+    AStar,
+    JPS,    // 8-connected, so paths may contain diagonal steps
+    Incremental,    // chase keeps its search tree between replans; patrol uses HPA* or A*
+    Hierarchical,   // HPA*; chase paths are refined one cluster at a time
+    FlowField       // chase follows a field shared by all guards; patrol uses A*
+};
+
 class Enemy {
 public:
-    Enemy(const std::vector<sf::RectangleShape>& walls,
-          const std::vector<bool>& coarseGrid,
-          int colsCoarse, int rowsCoarse,
+    Enemy(const OccupancyGrid& coarseGrid,
           const std::vector<Tile>& patrolTiles);
 
     void setChasing(bool chase);
+    void setPathMode(PathMode mode);
+    // Precomputed patrol legs; legs starting off-circuit still use the planner
+    void setPatrolRoutes(PatrolRouteCache* routes);
+    // Shared cluster graph; without one, hierarchical requests fall back to A*
+    void setHierarchy(HPAStar* hpa);
+    // Shared chase field; the first guard to see a new player tile rebuilds it
+    void setFlowField(FlowField* field);
     void update(Tile playerTile, float dt);
 
     sf::RectangleShape& shape();
+    sf::Vector2f getPosition() const;   // centre of the guard
 
 private:
-    const std::vector<sf::RectangleShape>& walls;
-    const std::vector<bool>& coarseGrid;
-    int colsCoarse, rowsCoarse;
+    const OccupancyGrid& coarseGrid;
+    PathMode pathMode = PathMode::Incremental;
+    AStar search;
+    JumpPointSearch jps;
+    IncrementalPlanner chasePlanner;
+    Tile chaseTarget{-1, -1};       // player tile the chase path was planned to
 
     std::vector<Tile> patrolTiles;
     size_t currentPatrolIndex = 0;
+    PatrolRouteCache* patrolRoutes = nullptr;
+    HPAStar* hierarchy = nullptr;
+    FlowField* flowField = nullptr;
 
     std::vector<Tile> path;
     size_t pi = 0;
@@ -38,6 +68,7 @@ private:
 
     Tile tileFrom, tileTo;
 
-    // Helper
+    // Helpers
     sf::Vector2f tileCenter(Tile tile) const;
+    std::vector<Tile> plan(Tile from, Tile to);
 };
\ No newline at end of file
@@ -1,69 +1,49 @@
 #include "entities/Player.h"
 #include "core/Collision.h"
 #include "core/Constants.h"
+#include <algorithm>
 #include <cmath>
-#include <iostream>
 
-Player::Player(const sf::Texture& texture, const std::vector<sf::RectangleShape>& W)
-    : walls(W)
+Player::Player(const sf::Vector2f& size, const CollisionIndex& W)
+    : body(150.f, 150.f, size.x, size.y), walls(W)
 {
-    sprite.setTexture(texture);
-    sprite.setScale(0.1f, 0.1f);
-    sprite.setPosition(150.f, 150.f);
 }
 
-void Player::handleInput(float dt) {
-    sf::Vector2f movement(0.f, 0.f);
-
-    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Left))  movement.x -= 1.f;
-    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) movement.x += 1.f;
-    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Up))    movement.y -= 1.f;
-    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Down))  movement.y += 1.f;
-
+void Player::move(sf::Vector2f movement, float dt) {
     if(movement.x != 0 || movement.y != 0) {
         float length = std::sqrt(movement.x*movement.x + movement.y*movement.y);
         movement = (movement / length) * PLAYER_SPEED * dt;
 
-        sf::FloatRect pb = sprite.getGlobalBounds();
+        sf::FloatRect pb = body;
 
         sf::FloatRect ph = pb; ph.left += movement.x;
-        if(!checkCollision(ph, walls)) sprite.move(movement.x, 0);
+        if(!checkCollision(ph, walls)) body.left += movement.x;
 
         sf::FloatRect pv = pb; pv.top += movement.y;
-        if(!checkCollision(pv, walls)) sprite.move(0, movement.y);
-
-        //std:: cout << ph.left << " " << pv.top << "\n";
+        if(!checkCollision(pv, walls)) body.top += movement.y;
     }
 }
 
 void Player::update() {
-    auto pos = sprite.getPosition();
-    auto bounds = sprite.getGlobalBounds();
-
-    pos.x = std::clamp(pos.x, 0.f, float(WORLD_W) - bounds.width);
-    pos.y = std::clamp(pos.y, 0.f, float(WORLD_H) - bounds.height);
-
-    sprite.setPosition(pos);
+    body.left = std::clamp(body.left, 0.f, float(WORLD_W) - body.width);
+    body.top = std::clamp(body.top, 0.f, float(WORLD_H) - body.height);
 }
 
 sf::Vector2f Player::getPosition() const {
-    return sprite.getPosition();
+    return sf::Vector2f(body.left, body.top);
 }
 
 const sf::FloatRect Player::getGlobalBounds() const {
-    return sprite.getGlobalBounds();
-}
-
-void Player::draw(sf::RenderWindow& window) {
-    window.draw(sprite);
+    return body;
 }
 
 // --- New methods for setting position ---
 
 void Player::setPosition(float x, float y) {
-    sprite.setPosition(x, y);
+    body.left = x;
+    body.top = y;
 }
 
 void Player::setPosition(const sf::Vector2f& pos) {
-    sprite.setPosition(pos);
+    setPosition(pos.x, pos.y);
 }
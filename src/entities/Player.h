@@ -1,19 +1,21 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <vector>
+#include "core/CollisionIndex.h"
 
+// The player's collision box. Drawing is left to the caller, so the same
+// body moves under the game loop and in the headless simulation.
 class Player {
-    sf::Sprite sprite;
-    const std::vector<sf::RectangleShape>& walls;
+    sf::FloatRect body;
+    const CollisionIndex& walls;
 
 public:
-    Player(const sf::Texture& texture, const std::vector<sf::RectangleShape>& walls);
+    Player(const sf::Vector2f& size, const CollisionIndex& walls);
 
-    void handleInput(float dt);
+    // Walk along dir (normalised here) for dt, sliding along walls
+    void move(sf::Vector2f dir, float dt);
     void update();
     sf::Vector2f getPosition() const;
     const sf::FloatRect getGlobalBounds() const;
-    void draw(sf::RenderWindow& window);
 
     // --- Added methods ---
     void setPosition(float x, float y);
@@ -5,11 +5,13 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
-#include <functional>
+#include <unordered_set>
+#include <memory>
 
 // Project headers - Core
 #include "core/Constants.h"         // WORLD_W, WORLD_H, TILE_SIZE, Vec2f, etc.
-#include "core/Collision.h"         // checkCollision(...)
+#include "core/Profiler.h"          // PROFILE_SCOPE(...)
+#include "core/ResourceCache.h"     // Shared fonts and textures
 
 // Project headers - Entities
 #include "entities/Enemy.h"         // Enemy class
@@ -18,15 +20,17 @@
 // Project headers - UI
 #include "ui/Minimap.h"             // Minimap HUD
 #include "ui/UI.h"
-#include "ui/isend.h"
+#include "ui/ProfilerOverlay.h"
+#include "ui/RenderTargetPool.h"    // Off-screen targets shared by the overlays
 
 // Project headers - World
 #include "world/MapLoader.hpp"      // Tiled map loader
+#include "world/BakedMap.h"         // Memory-mapped map bake
 #include "world/CollisionWalls.h"
-#include "world/WalkableGrid.h"
-#include "world/PatrolCircuit.h"
-#include "world/CoarseGrid.h"
-#include "world/PatrolTiles.h"
+#include "world/TaskZones.h"       // Task triggers indexed by tile
+
+// Project headers - Simulation
+#include "sim/GameSim.h"            // Fixed-timestep world and entity update
 
 // Project headers - Tasks
 #include "tasks/codechallenge.h"
@@ -40,6 +44,8 @@
 #include "tasks/CombinationLockOverlay.hpp"
 #include "tasks/PCSimulatorOverlay.hpp"
 #include "tasks/GradeChangerOverlay.hpp"
+#include "tasks/LazyOverlay.hpp"
+#include "tasks/TaskRegistry.hpp"    // Task overlays by Tiled type
 
 int main()
 {
@@ -83,7 +89,10 @@ int main()
     window.setActive(false);
     std::thread loaderThread([&]() {
         sf::Context ctx;
-        loadSuccess = map.load();
+        // The bake skips the JSON parse; fall back to it when there is none
+        loadSuccess = map.loadBaked("assets/eita.bake") || map.load();
+        if (loadSuccess)
+            map.mergeCollisionRects();   // no-op on a bake, whose walls are merged already
         done = true;
     });
     window.setActive(true);
@@ -119,139 +128,120 @@ int main()
         return -1;
     }
 
-    // --- Environment & enemy setup (modularized) ---
+    // --- Environment setup (modularized) ---
     auto walls = extractCollisionWalls(map);
-    auto grid = buildWalkableGrid(walls, WORLD_W, WORLD_H, TILE_SIZE);
-
-    // --- Patrol circuit setup (modularized) ---
-    const float ENEMY_SIZE = 36.f;
-    auto rawCircuit = getRawPatrolCircuit(); // From PatrolCircuit.h
-    auto circuit = filterPatrolCircuit(rawCircuit, ENEMY_SIZE, walls, checkCollision);
-
-    int pp = ENEMY_SIZE / TILE_SIZE;
-    int cols = WORLD_W / TILE_SIZE;
-    int rows = WORLD_H / TILE_SIZE;
-    int colsCoarse = cols - (pp - 1);
-    int rowsCoarse = rows - (pp - 1);
-
-    auto coarseGrid = buildCoarseGrid(grid, WORLD_W, WORLD_H, TILE_SIZE, ENEMY_SIZE);
-    auto patrolTiles = convertPatrolPointsToTiles(circuit, TILE_SIZE, ENEMY_SIZE, colsCoarse, rowsCoarse);
-
-    // --- Enemy creation (remains here) ---
-    Enemy enemy(walls, coarseGrid, colsCoarse, rowsCoarse, patrolTiles);
 
-    // --- Player setup ---
-    sf::Texture playerTex;
-    if (!playerTex.loadFromFile("assets/sprite.png"))
+    // --- Player sprite; its scaled size is the player's collision box ---
+    // Fonts and textures shared by the HUD and every task overlay
+    ResourceCache resources;
+    bool loaded = false;
+    auto playerTex = resources.texture("assets/sprite.png", &loaded);
+    if (!loaded)
         return -1;
-    Player player(playerTex, walls);
-    player.setPosition(WORLD_W / 2.f, WORLD_H / 2.f);
+    sf::Sprite playerSprite(*playerTex);
+    playerSprite.setScale(0.1f, 0.1f);
+    sf::FloatRect spriteBounds = playerSprite.getGlobalBounds();
+
+    // --- World, player and enemy, stepped at a fixed rate in the loop ---
+    const BakedMap* baked = map.getBaked();
+    SimWorld simWorld;
+    if (baked) {
+        simWorld.walkable = baked->walkable();
+        simWorld.coarse = baked->coarse(simWorld.walkable);
+        simWorld.patrolTiles = baked->patrolTiles();
+    } else {
+        simWorld = SimWorld::build(map.getCollisionRects());
+    }
+    GameSim sim(map.getCollisionRects(), {spriteBounds.width, spriteBounds.height},
+                std::move(simWorld), "assets/eita.routes");
+    // Keep freshly planned patrol legs next to the map for the next launch
+    if (!sim.routesLoaded()) sim.saveRoutes("assets/eita.routes");
+    Player& player = sim.player();
+    Enemy& enemy = sim.enemy();
 
     // --- HUD & UI setup ---
     sf::RectangleShape zone({200, 150});
     zone.setPosition(WORLD_W - 200, WORLD_H - 150);
     zone.setFillColor({0, 255, 0, 100});
-    sf::Font font;
-    if (!font.loadFromFile("assets/arial.ttf"))
+    auto fontHandle = resources.font("assets/arial.ttf", &loaded);
+    if (!loaded)
         return -1;
+    const sf::Font& font = *fontHandle;
     sf::Text uniqueText("Tasks done: 0", font, 24);
     uniqueText.setFillColor(sf::Color::White);
     Minimap minimap(WORLD_W, WORLD_H, font);
+    ProfilerOverlay profilerOverlay(font);
     sf::Clock clk;
+    float simTime = 0.f;
 
     // --- Overlays construction ---
-    CodeChallenge codeChallenge(800, 600);
-    WiFiServerTask wifiOffTask(800, 600);
-    WiFiLoginTask wifilinTask(800, 600);
-    TypingChallenge typingTask(800, 600);
-    PhotocopierTask photocopyTask(800, 600);
-    ComputerTaskOverlay compTermTask(800, 600);
-    IntegerOverflowOverlay overflowTask(800, 600);
-    CombinationLockOverlay lockerTask(800, 600);
-    PCSimulatorOverlay servTask(800, 600);
-    GradeChangerOverlay gradeChanger(800, 600);
+    // One per Tiled task type, in map-scan order. Each is built on first
+    // use and they take turns drawing into the pooled targets.
+    RenderTargetPool overlayTargets;
+    TaskRegistry taskOverlays;
+    taskOverlays.add("cout",    makeLazyOverlay([&] { return std::make_unique<CodeChallenge>(800, 600, resources, overlayTargets); }));
+    taskOverlays.add("wifioff", makeLazyOverlay([&] { return std::make_unique<WiFiServerTask>(800, 600, resources, overlayTargets); }));
+    taskOverlays.add("wifilin", makeLazyOverlay([&] { return std::make_unique<WiFiLoginTask>(800, 600, resources, overlayTargets); }));
+    taskOverlays.add("tyac",    makeLazyOverlay([&] { return std::make_unique<TypingChallenge>(800, 600, resources, overlayTargets); }));
+    taskOverlays.add("printer", makeLazyOverlay([&] { return std::make_unique<PhotocopierTask>(800, 600, resources, overlayTargets); }));
+    taskOverlays.add("typing",  makeLazyOverlay([&] { return std::make_unique<ComputerTaskOverlay>(800, 600, resources, overlayTargets); }));
+    taskOverlays.add("laptop",  makeLazyOverlay([&] { return std::make_unique<IntegerOverflowOverlay>(800, 600, resources, overlayTargets); }));
+    taskOverlays.add("locker",  makeLazyOverlay([&] { return std::make_unique<CombinationLockOverlay>(800, 600, resources, overlayTargets); }));
+    taskOverlays.add("serv",    makeLazyOverlay([&] { return std::make_unique<PCSimulatorOverlay>(800, 600, resources, overlayTargets); }));
+    taskOverlays.add("grade",   makeLazyOverlay([&] { return std::make_unique<GradeChangerOverlay>(800, 600, resources, overlayTargets); }));
 
     // --- Button sprite shared by tasks ---
-    sf::Texture btnTex;
-    if (!btnTex.loadFromFile("assets/buttonimg.png"))
+    auto btnTex = resources.texture("assets/buttonimg.png", &loaded);
+    if (!loaded)
         return -1;
-    sf::Sprite btn(btnTex);
+    sf::Sprite btn(*btnTex);
     btn.setPosition(750, 520);
     bool showButton = false;
 
     // --- Task integration setup ---
-    enum class TaskType {
-        None, Cout, WiFiOff, Wifilin, Tyac, Printer, CompTerm,
-        overflowTask, Locker, servTask, Gradechg
-    };
-
-    // Pull rect-lists from the map by your Tiled "type" string
-    const auto& coutRects = map.getTaskRects("cout");
-    const auto& wifiOffRects = map.getTaskRects("wifioff");
-    const auto& wifilinRects = map.getTaskRects("wifilin");
-    const auto& tyacRects = map.getTaskRects("tyac");
-    const auto& printerRects = map.getTaskRects("printer");
-    const auto& compTermRects = map.getTaskRects("typing");
-    const auto& overflowRects = map.getTaskRects("laptop");
-    const auto& lockerRects = map.getTaskRects("locker");
-    const auto& servRects = map.getTaskRects("serv");
-    const auto& gradechgRects = map.getTaskRects("grade");
     const auto& endtRects = map.getTaskRects("endt");
 
     bool hasWon = false;
 
-    struct TaskDef {
-        TaskType type;
-        const std::vector<sf::FloatRect>* rects;
-        std::function<void()> startFunc;
-        std::function<bool()> isDone;
-        bool counted = false;
-    };
-
-    std::vector<TaskDef> tasks = {
-        { TaskType::Cout, &coutRects, [&]() { codeChallenge.start(); }, [&]() { return codeChallenge.isFinished(); } },
-        { TaskType::WiFiOff, &wifiOffRects, [&]() { wifiOffTask.start(); }, [&]() { return wifiOffTask.isFinished(); } },
-        { TaskType::Wifilin, &wifilinRects, [&]() { wifilinTask.start(); }, [&]() { return wifilinTask.isFinished(); } },
-        { TaskType::Tyac, &tyacRects, [&]() { typingTask.start(); }, [&]() { return typingTask.isFinished(); } },
-        { TaskType::Printer, &printerRects, [&]() { photocopyTask.start(); }, [&]() { return photocopyTask.isFinished(); } },
-        { TaskType::CompTerm, &compTermRects, [&]() { compTermTask.start(); }, [&]() { return compTermTask.isFinished(); } },
-        { TaskType::overflowTask, &overflowRects, [&]() { overflowTask.start(); }, [&]() { return overflowTask.isFinished(); } },
-        { TaskType::Locker, &lockerRects, [&]() { lockerTask.start(); }, [&]() { return lockerTask.isFinished(); } },
-        { TaskType::servTask, &servRects, [&]() { servTask.start(); }, [&]() { return servTask.isFinished(); } },
-        { TaskType::Gradechg, &gradechgRects, [&]() { gradeChanger.start(); }, [&]() { return gradeChanger.isFinished(); } },
-    };
-
-    TaskType pendingTask = TaskType::None;
+    // Trigger tiles of each registered task, merged into zones and indexed
+    // per tile; task ids are registry positions, so scan order is kept
+    TaskZoneIndex taskZones(WORLD_W, WORLD_H, TILE_SIZE);
+    for (size_t i = 0; i < taskOverlays.size(); ++i)
+        taskZones.add(int(i), map.getTaskRects(taskOverlays.entries()[i].type));
+
+    TaskOverlay* activeOverlay = nullptr;    // the one overlay started last, until it closes
+    TaskOverlay* pendingTask = nullptr;      // the task under the player, offered by the button
+    std::unordered_set<const TaskOverlay*> completedTasks;
 
     // --- Main game loop ---
     while (window.isOpen()) {
-        sf::Event e;
-        while (window.pollEvent(e)) {
-            if (e.type == sf::Event::Closed) {
-                window.close();
-            }
-            // 1) Dispatch to any active overlay
-            else if (codeChallenge.isActive()) codeChallenge.handleEvent(e);
-            else if (wifiOffTask.isActive()) wifiOffTask.handleEvent(e);
-            else if (wifilinTask.isActive()) wifilinTask.handleEvent(e);
-            else if (typingTask.isActive()) typingTask.handleEvent(e);
-            else if (photocopyTask.isActive()) photocopyTask.handleEvent(e);
-            else if (compTermTask.isActive() || compTermTask.isFinished()) compTermTask.handleEvent(e);
-            else if (overflowTask.isActive()) overflowTask.handleEvent(e);
-            else if (lockerTask.isActive()) lockerTask.handleEvent(e);
-            else if (servTask.isActive()) servTask.handleEvent(e);
-            else if (gradeChanger.isActive()) gradeChanger.handleEvent(e);
-            // 2) Otherwise handle game input & button-click
-            else {
-                minimap.handleEvent(e, window);
-                if (showButton && e.type == sf::Event::MouseButtonPressed && e.mouseButton.button == sf::Mouse::Left) {
-                    sf::Vector2f mp(e.mouseButton.x, e.mouseButton.y);
-                    if (btn.getGlobalBounds().contains(mp) && pendingTask != TaskType::None) {
-                        for (auto& td : tasks) {
-                            if (td.type == pendingTask) {
-                                td.startFunc();
-                                break;
-                            }
+        Profiler::get().newFrame();
+
+        {
+            PROFILE_SCOPE("events");
+            sf::Event e;
+            while (window.pollEvent(e)) {
+                if (e.type == sf::Event::Closed) {
+                    window.close();
+                }
+                // Profiler: F3 shows the frame graph, F4 dumps a Chrome trace
+                else if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::F3) {
+                    profilerOverlay.toggle();
+                }
+                else if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::F4) {
+                    if (Profiler::get().writeChromeTrace("profile.json"))
+                        std::cout << "Wrote profile.json\n";
+                }
+                // 1) Dispatch to the running overlay
+                else if (activeOverlay && activeOverlay->takesInput()) activeOverlay->handleEvent(e);
+                // 2) Otherwise handle game input & button-click
+                else {
+                    minimap.handleEvent(e, window);
+                    if (showButton && e.type == sf::Event::MouseButtonPressed && e.mouseButton.button == sf::Mouse::Left) {
+                        sf::Vector2f mp(e.mouseButton.x, e.mouseButton.y);
+                        if (btn.getGlobalBounds().contains(mp) && pendingTask) {
+                            pendingTask->start();
+                            activeOverlay = pendingTask;
                         }
                     }
                 }
@@ -260,27 +250,24 @@ int main()
 
         // --- Updates ---
         float dt = clk.restart().asSeconds();
-        bool chase = false;
-        if (!codeChallenge.isActive() && !wifiOffTask.isActive() && !wifilinTask.isActive() &&
-            !typingTask.isActive() && !photocopyTask.isActive() && !compTermTask.isActive() &&
-            !overflowTask.isActive() && !lockerTask.isActive() && !servTask.isActive() && !gradeChanger.isActive())
+        bool caught = false;
+        bool overlayOpen = activeOverlay && activeOverlay->isActive();
         {
-            player.handleInput(dt);
+            PROFILE_SCOPE("sim");
+            SimInput input;
+            if (!overlayOpen)
+                input.move = readMoveInput();
+            else input.chase = true;
+
+            // Run whole fixed ticks; after a long stall the backlog is dropped, not replayed
+            simTime += std::min(dt, 0.25f);
+            while (simTime >= GameSim::FIXED_DT && !caught) {
+                caught = sim.step(input);
+                simTime -= GameSim::FIXED_DT;
+            }
         }
-        else chase = true;
-
-        player.update();
-        enemy.setChasing(chase);
 
-        // Update enemy using player's coarse tile
-        sf::Vector2f playerPos = player.getPosition();
-        int playerCx = int(playerPos.x / TILE_SIZE) - (pp / 2);
-        int playerCy = int(playerPos.y / TILE_SIZE) - (pp / 2);
-        playerCx = std::clamp(playerCx, 0, colsCoarse - 1);
-        playerCy = std::clamp(playerCy, 0, rowsCoarse - 1);
-        enemy.update({playerCx, playerCy}, dt);
-
-        if (isend(walls, player.getPosition(), enemy.shape().getPosition())) {
+        if (caught) {
             sf::Texture gameOverTexture;
             if (!gameOverTexture.loadFromFile("assets/gameover.png")) {
                 std::cerr << "Failed to load gameover.png\n";
@@ -303,101 +290,90 @@ int main()
         }
 
         // Determine which task tile we're on
-        pendingTask = TaskType::None;
-        if (!codeChallenge.isActive() && !wifiOffTask.isActive() && !wifilinTask.isActive() &&
-            !typingTask.isActive() && !photocopyTask.isActive() && !compTermTask.isActive() &&
-            !overflowTask.isActive() && !lockerTask.isActive() && !servTask.isActive() && !gradeChanger.isActive())
         {
-            sf::FloatRect pb = player.getGlobalBounds();
-            for (auto& td : tasks) {
-                for (auto& r : *td.rects) {
-                    if (r.intersects(pb)) {
-                        pendingTask = td.type;
-                        break;
-                    }
-                }
-                if (pendingTask != TaskType::None)
-                    break;
+            PROFILE_SCOPE("task scan");
+            pendingTask = nullptr;
+            if (!overlayOpen) {
+                int task = taskZones.find(player.getGlobalBounds());
+                if (task >= 0)
+                    pendingTask = taskOverlays.entries()[task].overlay.get();
             }
         }
-        showButton = (pendingTask != TaskType::None);
+
+        showButton = (pendingTask != nullptr);
 
         // Update overlays
-        codeChallenge.update(dt);
-        wifiOffTask.update(dt);
-        wifilinTask.update(dt);
-        typingTask.update(dt);
-        photocopyTask.update(dt);
-        compTermTask.update(dt);
-        overflowTask.update(dt);
-        lockerTask.update(dt);
-        servTask.update(dt);
-        gradeChanger.update(dt);
-
-        // Count completed tasks
-        for (auto& td : tasks) {
-            if (!td.counted && td.isDone()) {
-                td.counted = true;
-                uniqueCompleted++;
-                uniqueText.setString("Tasks done: " + std::to_string(uniqueCompleted));
-                if (!hasWon && uniqueCompleted == 10) {
-                    sf::FloatRect playerBounds = player.getGlobalBounds();
-                    for (const auto& rect : endtRects) {
-                        if (rect.intersects(playerBounds)) {
-                            hasWon = true;
-                            std::cout << "🏆 All tasks complete! You win!\n";
-                            window.close();
-                            break;
+        {
+            PROFILE_SCOPE("overlay update");
+            if (activeOverlay)
+                activeOverlay->update(dt);
+
+            // Count completed tasks
+            if (activeOverlay && activeOverlay->isFinished()) {
+                if (completedTasks.insert(activeOverlay).second) {
+                    uniqueCompleted++;
+                    uniqueText.setString("Tasks done: " + std::to_string(uniqueCompleted));
+                    if (!hasWon && uniqueCompleted == int(taskOverlays.size())) {
+                        sf::FloatRect playerBounds = player.getGlobalBounds();
+                        for (const auto& rect : endtRects) {
+                            if (rect.intersects(playerBounds)) {
+                                hasWon = true;
+                                std::cout << "🏆 All tasks complete! You win!\n";
+                                window.close();
+                                break;
+                            }
                         }
                     }
                 }
             }
+
+            // Let go of the overlay once it has closed
+            if (activeOverlay && !activeOverlay->isVisible() && !activeOverlay->takesInput())
+                activeOverlay = nullptr;
         }
 
         // --- Drawing ---
-        window.clear();
-        view.setCenter(player.getPosition());
-        window.setView(view);
-        window.draw(map);
-        window.draw(zone);
-        window.draw(enemy.shape());
-        player.draw(window);
-        drawScene(window, walls, enemy, player, uniqueText);
-
-        // HUD
-        sf::Vector2f tl = view.getCenter() - view.getSize() / 2.f;
-        uniqueText.setPosition(tl + Vec2f(10, 10));
-        window.draw(uniqueText);
-
-        window.setView(window.getDefaultView());
-        minimap.draw(window, map, walls, player, enemy);
-
-        if (showButton)
-            window.draw(btn);
-
-        // Draw overlays on top
-        if (codeChallenge.isActive())
-            codeChallenge.draw(window);
-        if (wifiOffTask.isActive())
-            wifiOffTask.draw(window);
-        if (wifilinTask.isActive() || wifilinTask.isFinished())
-            wifilinTask.draw(window);
-        if (typingTask.isActive() || typingTask.isFinished())
-            typingTask.draw(window);
-        if (photocopyTask.isActive() || photocopyTask.isFinished())
-            photocopyTask.draw(window);
-        if (compTermTask.isActive() || compTermTask.isFinished())
-            compTermTask.draw(window);
-        if (overflowTask.isActive() || overflowTask.isFinished())
-            overflowTask.draw(window);
-        if (lockerTask.isActive() || lockerTask.isFinished())
-            lockerTask.draw(window);
-        if (servTask.isActive() || servTask.isFinished())
-            servTask.draw(window);
-        if (gradeChanger.isActive() || gradeChanger.isFinished())
-            gradeChanger.draw(window);
+        {
+            PROFILE_SCOPE("draw world");
+            window.clear();
+            view.setCenter(player.getPosition());
+            window.setView(view);
+            window.draw(map);
+            window.draw(zone);
+            window.draw(enemy.shape());
+            playerSprite.setPosition(player.getPosition());
+            window.draw(playerSprite);
+            drawScene(window, sim.lightPolygon(), enemy, player, uniqueText);
+
+            // HUD
+            sf::Vector2f tl = view.getCenter() - view.getSize() / 2.f;
+            uniqueText.setPosition(tl + Vec2f(10, 10));
+            window.draw(uniqueText);
+        }
 
-        window.display();
+        {
+            PROFILE_SCOPE("minimap");
+            window.setView(window.getDefaultView());
+            minimap.draw(window, map, walls, playerSprite, enemy);
+        }
+
+        {
+            PROFILE_SCOPE("overlay draw");
+            if (showButton)
+                window.draw(btn);
+
+            // Draw the running overlay on top
+            if (activeOverlay && activeOverlay->isVisible())
+                activeOverlay->draw(window);
+        }
+
+        profilerOverlay.update();
+        profilerOverlay.draw(window);
+
+        {
+            PROFILE_SCOPE("display");   // includes the frame-limit sleep
+            window.display();
+        }
     }
     return 0;
 }
@@ -0,0 +1,66 @@
+// Offline map bake: parses the Tiled JSON once, derives the walkable and
+// coarse grids and the patrol tiles the way GameSim would, and writes all
+// of it to one binary file the game memory-maps at startup. The patrol
+// legs for those grids go to the route cache the game loads next to it.
+//
+//   GradeHeistBake [map.json] [out.bake] [out.routes]
+//
+// Rerun after editing the map; the game ignores a bake older than its map.
+#include <iostream>
+#include <string>
+
+#include "core/Constants.h"
+#include "sim/GameSim.h"
+#include "world/BakedMap.h"
+#include "world/MapLoader.hpp"
+#include "world/PatrolRouteCache.h"
+#include "world/WalkableGrid.h"
+
+int main(int argc, char** argv) {
+    std::string mapPath = argc > 1 ? argv[1] : "assets/eita.json";
+    std::string outPath = argc > 2 ? argv[2] : "assets/eita.bake";
+    std::string routesPath = argc > 3 ? argv[3] : "assets/eita.routes";
+
+    MapLoader map(mapPath, "", TILE_SIZE, TILE_SIZE);
+    if (!map.load(false)) {
+        std::cerr << "Map load failed\n";
+        return 1;
+    }
+
+    // Bake merged walls, but only if they block exactly the tiles the
+    // per-tile rects do
+    size_t tileWalls = map.getCollisionRects().size();
+    OccupancyGrid tileGrid = buildWalkableGrid(map.getCollisionRects(), WORLD_W, WORLD_H, TILE_SIZE);
+    map.mergeCollisionRects();
+    if (buildWalkableGrid(map.getCollisionRects(), WORLD_W, WORLD_H, TILE_SIZE) != tileGrid) {
+        std::cerr << "Merged walls block a different area than the tiles\n";
+        return 1;
+    }
+
+    SimWorld world = SimWorld::build(map.getCollisionRects());
+    if (!BakedMap::write(outPath, TILE_SIZE, TILE_SIZE, map.getVertices(),
+                         map.getCollisionRects(), map.getAllTaskRects(),
+                         world.walkable, world.coarse, world.patrolTiles))
+        return 1;
+
+    // Read it back through the same path the game takes
+    BakedMap check;
+    if (!check.open(outPath, TILE_SIZE, TILE_SIZE) ||
+        check.walkable() != world.walkable || check.coarse(world.walkable).cells != world.coarse.cells) {
+        std::cerr << "Baked map failed to read back: " << outPath << "\n";
+        return 1;
+    }
+
+    PatrolRouteCache routes(world.patrolTiles, world.coarse.cells);
+    routes.precomputeAll();
+    if (!routes.save(routesPath))
+        return 1;
+
+    std::cout << "Baked " << mapPath << " -> " << outPath << ": "
+              << check.vertices().size() / 4 << " tiles, "
+              << check.collisionRects().size() << " walls (from " << tileWalls << " tiles), "
+              << check.taskTypes().size() << " task types, "
+              << check.patrolTiles().size() << " patrol tiles; "
+              << routes.legCount() << " patrol legs -> " << routesPath << "\n";
+    return 0;
+}
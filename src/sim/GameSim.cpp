@@ -0,0 +1,92 @@
+#include "sim/GameSim.h"
+#include "core/Collision.h"
+#include "core/Constants.h"
+#include "core/Profiler.h"
+#include "ui/isend.h"
+#include "world/PatrolCircuit.h"
+#include "world/PatrolTiles.h"
+#include "world/WalkableGrid.h"
+#include <algorithm>
+#include <utility>
+
+SimWorld SimWorld::build(const std::vector<sf::FloatRect>& collisionRects) {
+    SimWorld w;
+    w.walkable = buildWalkableGrid(collisionRects, WORLD_W, WORLD_H, TILE_SIZE);
+    w.coarse = buildCoarseGrid(w.walkable, TILE_SIZE, ENEMY_SIZE);
+
+    CollisionIndex wallIndex(collisionRects, WORLD_W, WORLD_H, TILE_SIZE);
+    auto circuit = filterPatrolCircuit(getRawPatrolCircuit(), ENEMY_SIZE, wallIndex, checkCollision);
+    w.patrolTiles = convertPatrolPointsToTiles(circuit, TILE_SIZE, ENEMY_SIZE, w.coarse.cols, w.coarse.rows);
+    return w;
+}
+
+GameSim::GameSim(const std::vector<sf::FloatRect>& collisionRects,
+                 const sf::Vector2f& playerSize,
+                 const std::string& routesPath)
+    : GameSim(collisionRects, playerSize, SimWorld::build(collisionRects), routesPath)
+{
+}
+
+GameSim::GameSim(const std::vector<sf::FloatRect>& collisionRects,
+                 const sf::Vector2f& playerSize,
+                 SimWorld world,
+                 const std::string& routesPath)
+    : wallIndex(collisionRects, WORLD_W, WORLD_H, TILE_SIZE)
+    , grid(std::move(world.walkable))
+    , lightCaster(grid, TILE_SIZE, 4 * TILE_SIZE)
+    , coarseGrid(std::move(world.coarse))
+    , patrolTiles(std::move(world.patrolTiles))
+    , patrolRoutes(patrolTiles, coarseGrid.cells)
+    , hierarchy(coarseGrid.cells)
+    , chaseField(coarseGrid.cells)
+    , playerBody(playerSize, wallIndex)
+    , guard(coarseGrid.cells, patrolTiles)
+{
+    // Patrol legs never change for a map, so plan them once up front
+    routesFromFile = !routesPath.empty() && patrolRoutes.load(routesPath);
+    if (!routesFromFile) patrolRoutes.precomputeAll();
+
+    guard.setPatrolRoutes(&patrolRoutes);
+    guard.setHierarchy(&hierarchy);
+    guard.setFlowField(&chaseField);
+
+    playerBody.setPosition(WORLD_W / 2.f, WORLD_H / 2.f);
+    lightArea = lightCaster.visibility(guard.getPosition(), LIGHT_RADIUS);
+}
+
+bool GameSim::step(const SimInput& input) {
+    ++tick;
+    {
+        PROFILE_SCOPE("player");
+        if (!input.chase) playerBody.move(input.move, FIXED_DT);
+        playerBody.update();
+    }
+
+    {
+        PROFILE_SCOPE("enemy");
+        guard.setChasing(input.chase);
+
+        // Player's coarse tile, anchored like the guard's footprint
+        int pp = coarseGrid.footprint;
+        sf::Vector2f playerPos = playerBody.getPosition();
+        int playerCx = std::clamp(int(playerPos.x / TILE_SIZE) - (pp / 2), 0, coarseGrid.cols - 1);
+        int playerCy = std::clamp(int(playerPos.y / TILE_SIZE) - (pp / 2), 0, coarseGrid.rows - 1);
+        guard.update({playerCx, playerCy}, FIXED_DT);
+    }
+
+    // Timed here rather than in the kernels: the zone covers the light cast
+    PROFILE_SCOPE("isend");
+    lightArea = lightCaster.visibility(guard.getPosition(), LIGHT_RADIUS);
+    return isend(grid, lightArea, playerBody.getPosition());
+}
+
+bool GameSim::routesLoaded() const { return routesFromFile; }
+bool GameSim::saveRoutes(const std::string& path) const { return patrolRoutes.save(path); }
+
+uint64_t GameSim::getTick() const { return tick; }
+Player& GameSim::player() { return playerBody; }
+Enemy& GameSim::enemy() { return guard; }
+const Player& GameSim::player() const { return playerBody; }
+const Enemy& GameSim::enemy() const { return guard; }
+const OccupancyGrid& GameSim::walkable() const { return grid; }
+const VisibilityPolygon& GameSim::lightPolygon() const { return lightArea; }
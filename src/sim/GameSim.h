@@ -0,0 +1,88 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/CollisionIndex.h"
+#include "entities/Enemy.h"
+#include "entities/Player.h"
+#include "world/CoarseGrid.h"
+#include "world/FlowField.h"
+#include "world/HPAStar.h"
+#include "world/OccupancyGrid.h"
+#include "world/PatrolRouteCache.h"
+#include "world/VisibilityCaster.h"
+
+// Player intent for one tick
+struct SimInput {
+    sf::Vector2f move;      // direction, normalised by the player; zero = stand still
+    bool chase = false;     // a task overlay is open: the guard hunts the player
+};
+
+// Grids and patrol tiles derived from the collision rects. build() works
+// them out at startup; a baked map (see BakedMap) stores them ready-made.
+struct SimWorld {
+    OccupancyGrid walkable;     // true = cell overlaps a wall
+    CoarseGrid coarse;
+    std::vector<Tile> patrolTiles;
+
+    static SimWorld build(const std::vector<sf::FloatRect>& collisionRects);
+};
+
+// World and entity state of one game, advanced in fixed ticks. Nothing
+// here opens a window or reads devices, so the same core runs under the
+// game loop and headless in GradeHeistSim. Equal inputs from an equal
+// start give equal states.
+class GameSim {
+public:
+    static constexpr float FIXED_DT = 1.f / 60.f;
+
+    // routesPath: patrol leg cache next to the map to load; when it is missing,
+    // stale or empty the legs are planned in memory. Nothing is written here,
+    // see saveRoutes().
+    GameSim(const std::vector<sf::FloatRect>& collisionRects,
+            const sf::Vector2f& playerSize,
+            const std::string& routesPath = "");
+    // Same, with the derived grids already at hand
+    GameSim(const std::vector<sf::FloatRect>& collisionRects,
+            const sf::Vector2f& playerSize,
+            SimWorld world,
+            const std::string& routesPath = "");
+    // Planners keep references into the grids held below
+    GameSim(const GameSim&) = delete;
+    GameSim& operator=(const GameSim&) = delete;
+
+    // Advance one FIXED_DT tick; true if the guard sees the player afterwards
+    bool step(const SimInput& input);
+
+    uint64_t getTick() const;
+    Player& player();
+    Enemy& enemy();
+    const Player& player() const;
+    const Enemy& enemy() const;
+    // False when the legs were planned rather than loaded from routesPath
+    bool routesLoaded() const;
+    // Write the planned patrol legs for the next launch to load
+    bool saveRoutes(const std::string& path) const;
+    // Fine grid, true = cell overlaps a wall
+    const OccupancyGrid& walkable() const;
+    // Guard light as of the last tick, cast once per tick; isend tests
+    // against it and drawScene draws it
+    const VisibilityPolygon& lightPolygon() const;
+
+private:
+    // Declaration order is construction order: later members refer to earlier ones
+    CollisionIndex wallIndex;
+    OccupancyGrid grid;
+    VisibilityCaster lightCaster;
+    CoarseGrid coarseGrid;
+    std::vector<Tile> patrolTiles;
+    PatrolRouteCache patrolRoutes;
+    bool routesFromFile = false;
+    HPAStar hierarchy;
+    FlowField chaseField;
+    Player playerBody;
+    Enemy guard;
+    VisibilityPolygon lightArea;
+    uint64_t tick = 0;
+};
@@ -0,0 +1,97 @@
+// Headless driver for GameSim: steps the game with random player input as
+// fast as it can and reports the tick rate. Needs no window or display.
+//
+//   GradeHeistSim [ticks] [seed] [mode] [map.json]
+//
+// mode is one of bfs, astar, jps, incremental, hierarchical, flowfield.
+// The same seed and mode always replay the same game.
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "core/Constants.h"
+#include "sim/GameSim.h"
+#include "world/MapLoader.hpp"
+
+static bool parseMode(const char* name, PathMode& mode) {
+    static const struct { const char* name; PathMode mode; } MODES[] = {
+        {"bfs", PathMode::BFS}, {"astar", PathMode::AStar}, {"jps", PathMode::JPS},
+        {"incremental", PathMode::Incremental}, {"hierarchical", PathMode::Hierarchical},
+        {"flowfield", PathMode::FlowField},
+    };
+    for (auto& m : MODES) {
+        if (std::strcmp(name, m.name) == 0) {
+            mode = m.mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    uint64_t ticks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    unsigned seed = argc > 2 ? unsigned(std::strtoul(argv[2], nullptr, 10)) : 1u;
+    PathMode mode = PathMode::Incremental;
+    if (argc > 3 && !parseMode(argv[3], mode)) {
+        std::cerr << "Unknown path mode: " << argv[3] << "\n";
+        return 1;
+    }
+    std::string mapPath = argc > 4 ? argv[4] : "assets/eita.json";
+
+    MapLoader map(mapPath, "", TILE_SIZE, TILE_SIZE);
+    if (!map.load(false)) {
+        std::cerr << "Map load failed\n";
+        return 1;
+    }
+    map.mergeCollisionRects();
+
+    // Same box as the game's sprite.png at 0.1 scale
+    GameSim sim(map.getCollisionRects(), {44.6f, 55.9f});
+    sim.enemy().setPathMode(mode);
+    sf::Vector2f spawn = sim.player().getPosition();
+
+    // Scripted wandering: hold a random direction for a while, and now and
+    // then stand still in a "task" so the guard gives chase
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> axis(-1, 1);
+    std::uniform_int_distribution<int> holdTicks(30, 120);
+    std::uniform_int_distribution<int> taskTicks(60, 300);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    SimInput input;
+    int hold = 0;
+    uint64_t catches = 0, chaseTicks = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t t = 0; t < ticks; ++t) {
+        if (--hold <= 0) {
+            input.chase = percent(rng) < 10;
+            input.move = sf::Vector2f(float(axis(rng)), float(axis(rng)));
+            hold = input.chase ? taskTicks(rng) : holdTicks(rng);
+        }
+        chaseTicks += input.chase;
+        if (sim.step(input)) {
+            ++catches;
+            sim.player().setPosition(spawn);
+            sim.enemy().setChasing(false);
+            input.chase = false;
+            hold = 0;
+        }
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    sf::Vector2f p = sim.player().getPosition(), e = sim.enemy().getPosition();
+    std::cout << "ticks:        " << sim.getTick() << " (" << sim.getTick() * GameSim::FIXED_DT << " s game time)\n"
+              << "wall time:    " << secs << " s\n"
+              << "ticks/s:      " << (secs > 0 ? sim.getTick() / secs : 0) << "\n"
+              << "chase ticks:  " << chaseTicks << "\n"
+              << "catches:      " << catches << "\n"
+              << "final player: " << p.x << ", " << p.y << "\n"
+              << "final guard:  " << e.x << ", " << e.y << "\n";
+    return 0;
+}
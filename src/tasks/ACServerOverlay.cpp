@@ -1,8 +1,9 @@
 // ACServerOverlay.cpp
 #include "tasks/ACServerOverlay.hpp"
 
-ACServerOverlay::ACServerOverlay(unsigned width, unsigned height)
-: currentState(State::Inactive)
+ACServerOverlay::ACServerOverlay(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets)
+: targets(targets), m_size(width, height)
+, currentState(State::Inactive)
 , selectedRoom(0)
 , taskPassed(false)
 , backgroundColor(20,25,35)
@@ -11,9 +12,7 @@ ACServerOverlay::ACServerOverlay(unsigned width, unsigned height)
 , successColor(50,200,50)
 , failColor(200,50,50)
 {
-    m_rt.create(width, height);
-    m_overlay.setTexture(m_rt.getTexture());
-    font.loadFromFile("assets/arial.ttf");
+    font = resources.font("assets/arial.ttf");
 
     setupWelcomeScreen();
     setupRoomSelection();
@@ -65,56 +64,59 @@ void ACServerOverlay::draw(sf::RenderWindow& window) {
     if (currentState == State::Inactive)
         return;
 
-    m_rt.clear(backgroundColor);
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear(backgroundColor);
 
     switch (currentState) {
         case State::Welcome:
-            m_rt.draw(titleText);
-            m_rt.draw(welcomeText);
-            m_rt.draw(instructionText);
-            m_rt.draw(startButton);
-            m_rt.draw(startButtonText);
+            rt.draw(titleText);
+            rt.draw(welcomeText);
+            rt.draw(instructionText);
+            rt.draw(startButton);
+            rt.draw(startButtonText);
             break;
 
         case State::RoomSelection:
-            m_rt.draw(titleText);
+            rt.draw(titleText);
             {
                 sf::Text t = instructionText;
                 t.setString("Select a room to control its AC:");
                 t.setPosition(280,120);
-                m_rt.draw(t);
+                rt.draw(t);
             }
             for (size_t i=0; i<roomButtons.size(); ++i) {
-                m_rt.draw(roomButtons[i]);
-                m_rt.draw(roomTexts[i]);
+                rt.draw(roomButtons[i]);
+                rt.draw(roomTexts[i]);
             }
             break;
 
         case State::ACControl:
-            m_rt.draw(titleText);
-            m_rt.draw(selectedRoomText);
-            m_rt.draw(instructionText);
-            m_rt.draw(onButton);
-            m_rt.draw(onButtonText);
-            m_rt.draw(offButton);
-            m_rt.draw(offButtonText);
+            rt.draw(titleText);
+            rt.draw(selectedRoomText);
+            rt.draw(instructionText);
+            rt.draw(onButton);
+            rt.draw(onButtonText);
+            rt.draw(offButton);
+            rt.draw(offButtonText);
             break;
 
         case State::Result:
-            m_rt.draw(resultText);
-            m_rt.draw(instructionText);
-            m_rt.draw(closeButton);
-            m_rt.draw(closeButtonText);
+            rt.draw(resultText);
+            rt.draw(instructionText);
+            rt.draw(closeButton);
+            rt.draw(closeButtonText);
             break;
 
         default:
             break;
     }
 
-    m_rt.display();
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
     // Center and draw overlay
     auto ws = window.getSize();
-    auto rs = m_rt.getSize();
+    auto rs = rt.getSize();
     m_overlay.setPosition((ws.x-rs.x)*0.5f, (ws.y-rs.y)*0.5f);
     window.draw(m_overlay);
 }
@@ -124,19 +126,19 @@ bool ACServerOverlay::isFinished() const  { return currentState == State::Result
 bool ACServerOverlay::passed() const      { return taskPassed; }
 
 void ACServerOverlay::setupWelcomeScreen() {
-    titleText.setFont(font);
+    titleText.setFont(*font);
     titleText.setString("CSEDU's AC Server");
     titleText.setCharacterSize(42);
     titleText.setFillColor(primaryColor);
     titleText.setPosition(280,150);
 
-    welcomeText.setFont(font);
+    welcomeText.setFont(*font);
     welcomeText.setString("Wise people make wise decisions");
     welcomeText.setCharacterSize(28);
     welcomeText.setFillColor(sf::Color::Yellow);
     welcomeText.setPosition(250,250);
 
-    instructionText.setFont(font);
+    instructionText.setFont(*font);
     instructionText.setString("Click Start to begin your mission");
     instructionText.setCharacterSize(20);
     instructionText.setFillColor(sf::Color::White);
@@ -148,7 +150,7 @@ void ACServerOverlay::setupWelcomeScreen() {
     startButton.setOutlineThickness(3);
     startButton.setOutlineColor(primaryColor);
 
-    startButtonText.setFont(font);
+    startButtonText.setFont(*font);
     startButtonText.setString("START");
     startButtonText.setCharacterSize(24);
     startButtonText.setFillColor(sf::Color::White);
@@ -166,7 +168,7 @@ void ACServerOverlay::setupRoomSelection() {
         btn.setFillColor(buttonColor);
         btn.setOutlineThickness(2);
         btn.setOutlineColor(sf::Color::White);
-        sf::Text t; t.setFont(font);
+        sf::Text t; t.setFont(*font);
         t.setString("Room "+std::to_string(roomNumber));
         t.setCharacterSize(16);
         t.setFillColor(sf::Color::White);
@@ -178,12 +180,12 @@ void ACServerOverlay::setupRoomSelection() {
 }
 
 void ACServerOverlay::setupACControl() {
-    selectedRoomText.setFont(font);
+    selectedRoomText.setFont(*font);
     selectedRoomText.setCharacterSize(28);
     selectedRoomText.setFillColor(sf::Color::White);
     selectedRoomText.setPosition(300,200);
 
-    instructionText.setFont(font);
+    instructionText.setFont(*font);
     instructionText.setString("Choose AC control action:");
     instructionText.setCharacterSize(20);
     instructionText.setFillColor(sf::Color::White);
@@ -192,26 +194,26 @@ void ACServerOverlay::setupACControl() {
     onButton.setSize({180,80}); onButton.setPosition(250,350);
     onButton.setFillColor(sf::Color(200,80,80));
     onButton.setOutlineThickness(3); onButton.setOutlineColor(sf::Color::White);
-    onButtonText.setFont(font); onButtonText.setString("TURN ON AC");
+    onButtonText.setFont(*font); onButtonText.setString("TURN ON AC");
     onButtonText.setCharacterSize(20); onButtonText.setFillColor(sf::Color::White);
     onButtonText.setPosition(285,380);
 
     offButton.setSize({180,80}); offButton.setPosition(470,350);
     offButton.setFillColor(sf::Color(80,200,80));
     offButton.setOutlineThickness(3); offButton.setOutlineColor(sf::Color::White);
-    offButtonText.setFont(font); offButtonText.setString("TURN OFF AC");
+    offButtonText.setFont(*font); offButtonText.setString("TURN OFF AC");
     offButtonText.setCharacterSize(20); offButtonText.setFillColor(sf::Color::White);
     offButtonText.setPosition(500,380);
 }
 
 void ACServerOverlay::setupResultScreen() {
-    resultText.setFont(font); resultText.setCharacterSize(32);
+    resultText.setFont(*font); resultText.setCharacterSize(32);
     resultText.setPosition(250,250);
 
     closeButton.setSize({150,50}); closeButton.setPosition(375,450);
     closeButton.setFillColor(buttonColor);
     closeButton.setOutlineThickness(2); closeButton.setOutlineColor(sf::Color::White);
-    closeButtonText.setFont(font); closeButtonText.setString("CLOSE");
+    closeButtonText.setFont(*font); closeButtonText.setString("CLOSE");
     closeButtonText.setCharacterSize(18); closeButtonText.setFillColor(sf::Color::White);
     closeButtonText.setPosition(425,470);
 }
@@ -7,27 +7,31 @@
 #include <vector>
 #include <algorithm>
 #include <random>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
-class ACServerOverlay {
+class ACServerOverlay : public TaskOverlay {
 public:
     enum class State { Inactive, Welcome, RoomSelection, ACControl, Result };
 
-    ACServerOverlay(unsigned width, unsigned height);
+    ACServerOverlay(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets);
 
     // Start the task overlay
-    void start();
+    void start() override;
 
     // Handle single SFML event
-    void handleEvent(const sf::Event& event);
+    void handleEvent(const sf::Event& event) override;
 
     // Update per-frame (if needed)
-    void update(float dt);
+    void update(float dt) override;
 
     // Draw overlay atop main window
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
 
-    bool isActive()    const;
-    bool isFinished()  const;
+    bool isActive()    const override;
+    bool isFinished()  const override;
     bool passed()      const;
 
 private:
@@ -39,11 +43,12 @@ private:
     void showResult();
 
     // Off-screen render
-    sf::RenderTexture    m_rt;
+    RenderTargetPool&    targets;    // lends the off-screen target while drawing
+    sf::Vector2u         m_size;
     sf::Sprite           m_overlay;
 
     // Shared resources
-    sf::Font             font;
+    std::shared_ptr<const sf::Font> font;
     sf::Color            backgroundColor;
     sf::Color            primaryColor;
     sf::Color            buttonColor;
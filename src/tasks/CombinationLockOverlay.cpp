@@ -4,22 +4,19 @@
 #include <cmath>
 #include <iostream>
 
-CombinationLockOverlay::CombinationLockOverlay(unsigned w, unsigned h)
-: currentState(State::Inactive)
+CombinationLockOverlay::CombinationLockOverlay(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets)
+: targets(targets), m_size(w, h)
+, currentState(State::Inactive)
 , taskPassed(false)
 , autoClose(false)
 , rng(std::random_device{}())
 {
-    if (!m_rt.create(w, h))
-        std::cerr << "Error: cannot create CombinationLockOverlay\n";
-    m_overlay.setTexture(m_rt.getTexture());
+    font = resources.font("assets/arial.ttf");
+
     setupUI();
 }
 
 void CombinationLockOverlay::setupUI() {
-    if (!font.loadFromFile("assets/arial.ttf"))
-        std::cerr << "Warning: could not load arial.ttf\n";
-
     correctCode       = "745268";
     hintText          = "Put all the numbers u got throughout the whole journey";
     maxDigits         = 6;
@@ -37,7 +34,7 @@ void CombinationLockOverlay::setupUI() {
 
 void CombinationLockOverlay::setupBackground() {
     backgroundParticles.clear();
-    std::uniform_int_distribution<int> distSize(2,5), distX(0,m_rt.getSize().x), distY(0,m_rt.getSize().y), distCol(100,200);
+    std::uniform_int_distribution<int> distSize(2,5), distX(0,m_size.x), distY(0,m_size.y), distCol(100,200);
     for (int i = 0; i < 20; ++i) {
         sf::CircleShape p(distSize(rng));
         p.setPosition(distX(rng), distY(rng));
@@ -81,7 +78,7 @@ void CombinationLockOverlay::setupVisualElements() {
         digitBoxes.push_back(box);
 
         sf::Text t;
-        t.setFont(font);
+        t.setFont(*font);
         t.setCharacterSize(24);
         t.setFillColor({0,255,0});
         t.setPosition(255.f + i*50.f, 235.f);
@@ -101,7 +98,7 @@ void CombinationLockOverlay::setupVisualElements() {
         numberButtons.push_back(btn);
 
         sf::Text txt;
-        txt.setFont(font);
+        txt.setFont(*font);
         txt.setString(std::to_string(i));
         txt.setCharacterSize(24);
         txt.setFillColor(sf::Color::White);
@@ -122,7 +119,7 @@ void CombinationLockOverlay::setupVisualElements() {
         numberButtons.push_back(btn);
 
         sf::Text txt;
-        txt.setFont(font);
+        txt.setFont(*font);
         txt.setString("0");
         txt.setCharacterSize(24);
         txt.setFillColor(sf::Color::White);
@@ -148,7 +145,7 @@ void CombinationLockOverlay::setupVisualElements() {
 }
 
 void CombinationLockOverlay::setupTexts() {
-    titleText.setFont(font);
+    titleText.setFont(*font);
     titleText.setString("Welcome to the Last Stage");
     titleText.setCharacterSize(28);
     titleText.setFillColor({255,100,100});
@@ -156,7 +153,7 @@ void CombinationLockOverlay::setupTexts() {
     titleText.setOutlineThickness(2.f);
     titleText.setPosition(200.f,20.f);
 
-    hintDisplayText.setFont(font);
+    hintDisplayText.setFont(*font);
     hintDisplayText.setString("HINT: " + hintText);
     hintDisplayText.setCharacterSize(16);
     hintDisplayText.setFillColor({255,255,100});
@@ -164,7 +161,7 @@ void CombinationLockOverlay::setupTexts() {
     hintDisplayText.setOutlineThickness(1.f);
     hintDisplayText.setPosition(50.f,120.f);
 
-    codeDisplayText.setFont(font);
+    codeDisplayText.setFont(*font);
     codeDisplayText.setString("Enter 6-digit code:");
     codeDisplayText.setCharacterSize(18);
     codeDisplayText.setFillColor(sf::Color::White);
@@ -172,7 +169,7 @@ void CombinationLockOverlay::setupTexts() {
     codeDisplayText.setOutlineThickness(1.f);
     codeDisplayText.setPosition(280.f,200.f);
 
-    instructionText.setFont(font);
+    instructionText.setFont(*font);
     instructionText.setString("Use keyboard or click digits - order doesn't matter");
     instructionText.setCharacterSize(14);
     instructionText.setFillColor({100,255,255});
@@ -180,7 +177,7 @@ void CombinationLockOverlay::setupTexts() {
     instructionText.setOutlineThickness(1.f);
     instructionText.setPosition(180.f,290.f);
 
-    enterButtonText.setFont(font);
+    enterButtonText.setFont(*font);
     enterButtonText.setString("ENTER");
     enterButtonText.setCharacterSize(16);
     enterButtonText.setFillColor(sf::Color::White);
@@ -188,7 +185,7 @@ void CombinationLockOverlay::setupTexts() {
     enterButtonText.setOutlineThickness(1.f);
     enterButtonText.setPosition(285.f,335.f);
 
-    clearButtonText.setFont(font);
+    clearButtonText.setFont(*font);
     clearButtonText.setString("CLEAR");
     clearButtonText.setCharacterSize(16);
     clearButtonText.setFillColor(sf::Color::White);
@@ -196,20 +193,20 @@ void CombinationLockOverlay::setupTexts() {
     clearButtonText.setOutlineThickness(1.f);
     clearButtonText.setPosition(465.f,335.f);
 
-    attemptText.setFont(font);
+    attemptText.setFont(*font);
     attemptText.setCharacterSize(18);
     attemptText.setFillColor(sf::Color::Yellow);
     attemptText.setOutlineColor(sf::Color::Black);
     attemptText.setOutlineThickness(1.f);
     attemptText.setPosition(500.f,280.f);
 
-    resultText.setFont(font);
+    resultText.setFont(*font);
     resultText.setCharacterSize(22);
     resultText.setOutlineColor(sf::Color::Black);
     resultText.setOutlineThickness(2.f);
     resultText.setPosition(150.f,420.f);
 
-    exitText.setFont(font);
+    exitText.setFont(*font);
     exitText.setString("Press ESC or ENTER to close");
     exitText.setCharacterSize(16);
     exitText.setFillColor(sf::Color::White);
@@ -427,9 +424,9 @@ void CombinationLockOverlay::updateBackground(){
         auto pos=p.getPosition();
         pos.x += dx(rng)*dt;
         pos.y += std::sin(pos.x*0.01f)*20.f*dt;
-        if(pos.x>m_rt.getSize().x+20){
+        if(pos.x>m_size.x+20){
             pos.x=-20;
-            pos.y=rng()%m_rt.getSize().y;
+            pos.y=rng()%m_size.y;
         }
         p.setPosition(pos);
     }
@@ -438,34 +435,37 @@ void CombinationLockOverlay::updateBackground(){
 void CombinationLockOverlay::draw(sf::RenderWindow& window){
     if(currentState==State::Inactive) return;
 
-    m_rt.clear({0,0,0,180});
-    for(auto& p:backgroundParticles) m_rt.draw(p);
-    m_rt.draw(titleText);
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear({0,0,0,180});
+    for(auto& p:backgroundParticles) rt.draw(p);
+    rt.draw(titleText);
     if(currentState==State::HintDisplay)
-        m_rt.draw(hintDisplayText);
+        rt.draw(hintDisplayText);
 
     // UI
-    m_rt.draw(lockFrame);
-    m_rt.draw(lockDial);
-    m_rt.draw(codeDisplay);
-    m_rt.draw(codeDisplayText);
-    for(auto& box:digitBoxes) m_rt.draw(box);
-    for(auto& txt:digitTexts) m_rt.draw(txt);
-    for(auto& btn:numberButtons) m_rt.draw(btn);
-    for(auto& txt:buttonTexts) m_rt.draw(txt);
-    m_rt.draw(enterButton);
-    m_rt.draw(clearButton);
-    m_rt.draw(enterButtonText);
-    m_rt.draw(clearButtonText);
-    m_rt.draw(instructionText);
-    m_rt.draw(attemptText);
+    rt.draw(lockFrame);
+    rt.draw(lockDial);
+    rt.draw(codeDisplay);
+    rt.draw(codeDisplayText);
+    for(auto& box:digitBoxes) rt.draw(box);
+    for(auto& txt:digitTexts) rt.draw(txt);
+    for(auto& btn:numberButtons) rt.draw(btn);
+    for(auto& txt:buttonTexts) rt.draw(txt);
+    rt.draw(enterButton);
+    rt.draw(clearButton);
+    rt.draw(enterButtonText);
+    rt.draw(clearButtonText);
+    rt.draw(instructionText);
+    rt.draw(attemptText);
     if(currentState==State::Completed){
-        m_rt.draw(resultText);
-        m_rt.draw(exitText);
+        rt.draw(resultText);
+        rt.draw(exitText);
     }
 
-    m_rt.display();
-    auto ws=window.getSize(), rs=m_rt.getSize();
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
+    auto ws=window.getSize(), rs=rt.getSize();
     m_overlay.setPosition(
       (ws.x-rs.x)/2.f,
       (ws.y-rs.y)/2.f
@@ -4,30 +4,34 @@
 #include <vector>
 #include <string>
 #include <random>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
-class CombinationLockOverlay {
+class CombinationLockOverlay : public TaskOverlay {
 public:
     enum class State { Inactive, HintDisplay, Playing, Completed };
 
     // w×h = the size you pass from main (e.g. 800×600)
-    CombinationLockOverlay(unsigned w, unsigned h);
+    CombinationLockOverlay(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets);
 
     // Called when the player steps on the “locker” tile
-    void start();
+    void start() override;
 
     // Forward SFML events from your main loop
-    void handleEvent(const sf::Event& e);
+    void handleEvent(const sf::Event& e) override;
 
     // Per-frame update (handles auto-close, animations)
-    void update(float dt);
+    void update(float dt) override;
 
     // Draw into your existing RenderWindow
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
 
     // Query from main:
-    bool isActive()   const;  // true while HintDisplay or Playing
-    bool isFinished() const;  // true once Completed
-    bool passed()     const;  // true if the answer was correct
+    bool isActive()   const override;  // true while HintDisplay or Playing
+    bool isFinished() const override;  // true once Completed
+    bool passed()     const;           // true if the answer was correct
 
 private:
     // Helpers to build and manage UI
@@ -44,11 +48,12 @@ private:
                           const std::string& correct);
 
     // Off-screen render target + sprite
-    sf::RenderTexture      m_rt;
+    RenderTargetPool&      targets;    // lends the off-screen target while drawing
+    sf::Vector2u           m_size;
     sf::Sprite             m_overlay;
 
     // Font & texts
-    sf::Font               font;
+    std::shared_ptr<const sf::Font> font;
     sf::Text               titleText;
     sf::Text               hintDisplayText;
     sf::Text               codeDisplayText;
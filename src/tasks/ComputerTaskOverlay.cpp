@@ -2,11 +2,12 @@
 #include "tasks/ComputerTaskOverlay.hpp"
 #include <algorithm>
 
-ComputerTaskOverlay::ComputerTaskOverlay(unsigned width, unsigned height)
-: rng(std::random_device{}()), currentState(State::Inactive), taskPassed(false)
+ComputerTaskOverlay::ComputerTaskOverlay(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets)
+: targets(targets), m_size(width, height)
+, rng(std::random_device{}()), currentState(State::Inactive), taskPassed(false)
 {
-    m_rt.create(width, height);
-    m_overlay.setTexture(m_rt.getTexture());
+    font = resources.font("assets/arial.ttf");
+
     setupUI();
 
     taskLines = {
@@ -26,10 +27,9 @@ ComputerTaskOverlay::ComputerTaskOverlay(unsigned width, unsigned height)
 }
 
 void ComputerTaskOverlay::setupUI() {
-    font.loadFromFile("assets/arial.ttf");
     backgroundColor = sf::Color(15,15,25,200);
-    screenBorder.setSize({static_cast<float>(m_rt.getSize().x - 20),
-                          static_cast<float>(m_rt.getSize().y - 20)});
+    screenBorder.setSize({static_cast<float>(m_size.x - 20),
+                          static_cast<float>(m_size.y - 20)});
     screenBorder.setPosition(10,10);
     screenBorder.setFillColor(sf::Color(0,40,0));
     screenBorder.setOutlineThickness(3);
@@ -41,33 +41,33 @@ void ComputerTaskOverlay::setupUI() {
     inputBox.setOutlineThickness(2);
     inputBox.setOutlineColor(sf::Color::Cyan);
 
-    titleText.setFont(font);
+    titleText.setFont(*font);
     titleText.setString("=== COMPUTER TERMINAL ACCESS ===");
     titleText.setCharacterSize(28);
     titleText.setFillColor(sf::Color::Green);
     titleText.setPosition(100.f,30.f);
 
-    promptText.setFont(font);
+    promptText.setFont(*font);
     promptText.setString("ENTER COMMAND:");
     promptText.setCharacterSize(20);
     promptText.setFillColor(sf::Color::Yellow);
     promptText.setPosition(100.f,350.f);
 
-    taskText.setFont(font);
+    taskText.setFont(*font);
     taskText.setCharacterSize(24);
     taskText.setFillColor(sf::Color::Cyan);
     taskText.setPosition(100.f,150.f);
 
-    inputText.setFont(font);
+    inputText.setFont(*font);
     inputText.setCharacterSize(22);
     inputText.setFillColor(sf::Color::White);
     inputText.setPosition(110.f,410.f);
 
-    resultText.setFont(font);
+    resultText.setFont(*font);
     resultText.setCharacterSize(24);
     resultText.setPosition(100.f,480.f);
 
-    exitText.setFont(font);
+    exitText.setFont(*font);
     exitText.setString("Press ESC to exit");
     exitText.setCharacterSize(20);
     exitText.setFillColor(sf::Color::Green);
@@ -148,33 +148,36 @@ void ComputerTaskOverlay::update(float) {}
 void ComputerTaskOverlay::draw(sf::RenderWindow& window) {
     if (currentState == State::Inactive) return;
 
-    m_rt.clear(backgroundColor);
-    m_rt.draw(screenBorder);
-    m_rt.draw(titleText);
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear(backgroundColor);
+    rt.draw(screenBorder);
+    rt.draw(titleText);
 
     if (currentState == State::Playing) {
-        m_rt.draw(taskText);
-        m_rt.draw(promptText);
-        m_rt.draw(inputBox);
-        m_rt.draw(inputText);
+        rt.draw(taskText);
+        rt.draw(promptText);
+        rt.draw(inputBox);
+        rt.draw(inputText);
         sf::RectangleShape cursor({3.f,22.f});
         cursor.setFillColor(sf::Color::White);
         cursor.setPosition(inputText.getPosition().x +
                            inputText.getLocalBounds().width,
                            inputText.getPosition().y);
         static int cnt = 0; cnt++;
-        if ((cnt/30)%2 == 0) m_rt.draw(cursor);
+        if ((cnt/30)%2 == 0) rt.draw(cursor);
     } else {
-        m_rt.draw(taskText);
-        m_rt.draw(inputBox);
-        m_rt.draw(inputText);
-        m_rt.draw(resultText);
-        m_rt.draw(exitText);
+        rt.draw(taskText);
+        rt.draw(inputBox);
+        rt.draw(inputText);
+        rt.draw(resultText);
+        rt.draw(exitText);
     }
 
-    m_rt.display();
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
     auto ws = window.getSize();
-    auto rs = m_rt.getSize();
+    auto rs = rt.getSize();
     m_overlay.setPosition((ws.x - rs.x)*0.5f,
                           (ws.y - rs.y)*0.5f);
     window.draw(m_overlay);
@@ -188,6 +191,10 @@ bool ComputerTaskOverlay::isFinished() const {
     return currentState == State::Completed;
 }
 
+bool ComputerTaskOverlay::takesInput() const {
+    return currentState != State::Inactive;
+}
+
 bool ComputerTaskOverlay::passed() const {
     return taskPassed;
 }
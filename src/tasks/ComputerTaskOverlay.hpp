@@ -5,20 +5,25 @@
 #include <string>
 #include <vector>
 #include <random>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
-class ComputerTaskOverlay {
+class ComputerTaskOverlay : public TaskOverlay {
 public:
     enum class State { Inactive, Playing, Completed };
 
-    ComputerTaskOverlay(unsigned width, unsigned height);
+    ComputerTaskOverlay(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets);
 
-    void start();
-    void handleEvent(const sf::Event& e);
-    void update(float dt);
-    void draw(sf::RenderWindow& window);
+    void start() override;
+    void handleEvent(const sf::Event& e) override;
+    void update(float dt) override;
+    void draw(sf::RenderWindow& window) override;
 
-    bool isActive() const;
-    bool isFinished() const;
+    bool isActive() const override;
+    bool isFinished() const override;
+    bool takesInput() const override;   // Escape still closes the result screen
     bool passed() const;
 
 private:
@@ -26,10 +31,11 @@ private:
     void pickNewTask();
     void checkTaskCompletion();
 
-    sf::RenderTexture m_rt;
+    RenderTargetPool& targets;    // lends the off-screen target while drawing
+    sf::Vector2u      m_size;
     sf::Sprite       m_overlay;
 
-    sf::Font          font;
+    std::shared_ptr<const sf::Font> font;
     sf::Text          titleText;
     sf::Text          taskText;
     sf::Text          promptText;
@@ -3,8 +3,9 @@
 #include <cctype>
 #include <iostream>
 
-GradeChangerOverlay::GradeChangerOverlay(unsigned w, unsigned h)
+GradeChangerOverlay::GradeChangerOverlay(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets)
 : currentPhase(Inactive)
+, targets(targets), m_size(w, h)
 , usernameActive(false)
 , passwordActive(false)
 , loginSuccess(false)
@@ -14,11 +15,7 @@ GradeChangerOverlay::GradeChangerOverlay(unsigned w, unsigned h)
 , closeDelay(2.f)
 , shouldClose(false)
 {
-    if (!m_rt.create(w, h))
-        std::cerr << "Error: cannot create GradeChangerOverlay\n";
-    m_overlay.setTexture(m_rt.getTexture());
-    if (!font.loadFromFile("assets/arial.ttf"))
-        std::cerr << "Warning: could not load arial.ttf\n";
+    font = resources.font("assets/arial.ttf");
     setupUI();
 }
 
@@ -29,14 +26,14 @@ void GradeChangerOverlay::setupUI() {
 
 void GradeChangerOverlay::setupLoginUI() {
     // Title
-    loginTitleText.setFont(font);
+    loginTitleText.setFont(*font);
     loginTitleText.setString("Admin Login");
     loginTitleText.setCharacterSize(28);
     loginTitleText.setFillColor(sf::Color::White);
     loginTitleText.setPosition(200, 30);
 
     // Username label & box
-    usernameLabel.setFont(font);
+    usernameLabel.setFont(*font);
     usernameLabel.setString("Username:");
     usernameLabel.setCharacterSize(18);
     usernameLabel.setFillColor(sf::Color::Yellow);
@@ -48,7 +45,7 @@ void GradeChangerOverlay::setupLoginUI() {
     usernameBox.setOutlineColor(sf::Color::Blue);
     usernameBox.setPosition(50, 130);
 
-    usernameText.setFont(font);
+    usernameText.setFont(*font);
     usernameText.setCharacterSize(16);
     usernameText.setFillColor(sf::Color::Black);
     usernameText.setPosition(55, 140);
@@ -61,7 +58,7 @@ void GradeChangerOverlay::setupLoginUI() {
     passwordBox = usernameBox;
     passwordBox.setPosition(50, 220);
 
-    passwordText.setFont(font);
+    passwordText.setFont(*font);
     passwordText.setCharacterSize(16);
     passwordText.setFillColor(sf::Color::Black);
     passwordText.setPosition(55, 230);
@@ -73,28 +70,28 @@ void GradeChangerOverlay::setupLoginUI() {
     loginButton.setOutlineColor(sf::Color::White);
     loginButton.setPosition(50, 280);
 
-    loginButtonText.setFont(font);
+    loginButtonText.setFont(*font);
     loginButtonText.setString("Login");
     loginButtonText.setCharacterSize(16);
     loginButtonText.setFillColor(sf::Color::White);
     loginButtonText.setPosition(75, 295);
 
     // Result
-    loginResultText.setFont(font);
+    loginResultText.setFont(*font);
     loginResultText.setCharacterSize(18);
     loginResultText.setFillColor(sf::Color::Red);
     loginResultText.setPosition(50, 340);
 }
 
 void GradeChangerOverlay::setupGradeUI() {
-    gradeTitleText.setFont(font);
+    gradeTitleText.setFont(*font);
     gradeTitleText.setString("Grade Changer");
     gradeTitleText.setCharacterSize(28);
     gradeTitleText.setFillColor(sf::Color::White);
     gradeTitleText.setPosition(180, 30);
 
     // Name label & box
-    nameLabel.setFont(font);
+    nameLabel.setFont(*font);
     nameLabel.setString("Student Name:");
     nameLabel.setCharacterSize(18);
     nameLabel.setFillColor(sf::Color::Yellow);
@@ -106,13 +103,13 @@ void GradeChangerOverlay::setupGradeUI() {
     nameBox.setOutlineColor(sf::Color::Blue);
     nameBox.setPosition(50, 130);
 
-    nameText.setFont(font);
+    nameText.setFont(*font);
     nameText.setCharacterSize(16);
     nameText.setFillColor(sf::Color::Black);
     nameText.setPosition(55, 140);
 
     // Grade label & box
-    gradeLabel.setFont(font);
+    gradeLabel.setFont(*font);
     gradeLabel.setString("Grade:");
     gradeLabel.setCharacterSize(18);
     gradeLabel.setFillColor(sf::Color::Yellow);
@@ -124,7 +121,7 @@ void GradeChangerOverlay::setupGradeUI() {
     gradeBox.setOutlineColor(sf::Color::Blue);
     gradeBox.setPosition(50, 220);
 
-    gradeText.setFont(font);
+    gradeText.setFont(*font);
     gradeText.setCharacterSize(16);
     gradeText.setFillColor(sf::Color::Black);
     gradeText.setPosition(55, 230);
@@ -136,14 +133,14 @@ void GradeChangerOverlay::setupGradeUI() {
     submitButton.setOutlineColor(sf::Color::White);
     submitButton.setPosition(50, 280);
 
-    submitButtonText.setFont(font);
+    submitButtonText.setFont(*font);
     submitButtonText.setString("Submit");
     submitButtonText.setCharacterSize(16);
     submitButtonText.setFillColor(sf::Color::White);
     submitButtonText.setPosition(70, 295);
 
     // Submit result
-    submitResultText.setFont(font);
+    submitResultText.setFont(*font);
     submitResultText.setCharacterSize(20);
     submitResultText.setFillColor(sf::Color::Green);
     submitResultText.setPosition(50, 340);
@@ -307,36 +304,39 @@ void GradeChangerOverlay::update(float dt) {
 void GradeChangerOverlay::draw(sf::RenderWindow& window) {
     if (currentPhase == Inactive) return;
 
-    m_rt.clear({0,0,0,180});
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear({0,0,0,180});
 
     if (currentPhase == Login) {
-        m_rt.draw(loginTitleText);
-        m_rt.draw(usernameLabel);
-        m_rt.draw(usernameBox);
-        m_rt.draw(usernameText);
-        m_rt.draw(passwordLabel);
-        m_rt.draw(passwordBox);
-        m_rt.draw(passwordText);
-        m_rt.draw(loginButton);
-        m_rt.draw(loginButtonText);
-        m_rt.draw(loginResultText);
+        rt.draw(loginTitleText);
+        rt.draw(usernameLabel);
+        rt.draw(usernameBox);
+        rt.draw(usernameText);
+        rt.draw(passwordLabel);
+        rt.draw(passwordBox);
+        rt.draw(passwordText);
+        rt.draw(loginButton);
+        rt.draw(loginButtonText);
+        rt.draw(loginResultText);
     } else { // Grade or Completed
-        m_rt.draw(gradeTitleText);
-        m_rt.draw(nameLabel);
-        m_rt.draw(nameBox);
-        m_rt.draw(nameText);
-        m_rt.draw(gradeLabel);
-        m_rt.draw(gradeBox);
-        m_rt.draw(gradeText);
-        m_rt.draw(submitButton);
-        m_rt.draw(submitButtonText);
-        m_rt.draw(submitResultText);
+        rt.draw(gradeTitleText);
+        rt.draw(nameLabel);
+        rt.draw(nameBox);
+        rt.draw(nameText);
+        rt.draw(gradeLabel);
+        rt.draw(gradeBox);
+        rt.draw(gradeText);
+        rt.draw(submitButton);
+        rt.draw(submitButtonText);
+        rt.draw(submitResultText);
     }
 
-    m_rt.display();
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
 
     auto ws = window.getSize();
-    auto rs = m_rt.getSize();
+    auto rs = rt.getSize();
     m_overlay.setPosition((ws.x - rs.x)/2.f, (ws.y - rs.y)/2.f);
     window.draw(m_overlay);
 }
@@ -2,39 +2,44 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
-class GradeChangerOverlay {
+class GradeChangerOverlay : public TaskOverlay {
 public:
     // Construct with overlay width & height
-    GradeChangerOverlay(unsigned w, unsigned h);
+    GradeChangerOverlay(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets);
 
     // Start the overlay (when player steps on the tile)
-    void start();
+    void start() override;
 
     // Forward SFML events
-    void handleEvent(const sf::Event& e);
+    void handleEvent(const sf::Event& e) override;
 
     // Per-frame update (handles auto-close timing)
-    void update(float dt);
+    void update(float dt) override;
 
     // Draw onto your main RenderWindow
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
 
     // State queries
-    bool isActive()   const;  // true during login or grade phases
-    bool isFinished() const;  // true after grade submission, before auto-close
-    bool passed()     const;  // true if grade was successfully changed
+    bool isActive()   const override;  // true during login or grade phases
+    bool isFinished() const override;  // true after grade submission, before auto-close
+    bool passed()     const;           // true if grade was successfully changed
 
 private:
     enum Phase { Inactive, Login, Grade, Completed };
     Phase            currentPhase;
 
     // Offscreen render-texture & overlay sprite
-    sf::RenderTexture m_rt;
+    RenderTargetPool& targets;    // lends the off-screen target while drawing
+    sf::Vector2u      m_size;
     sf::Sprite        m_overlay;
 
     // Shared font
-    sf::Font          font;
+    std::shared_ptr<const sf::Font> font;
 
     // --- LOGIN UI ---
     sf::Text           loginTitleText;
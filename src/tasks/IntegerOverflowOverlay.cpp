@@ -5,18 +5,19 @@
 #include <cctype>
 #include <sstream>
 
-IntegerOverflowOverlay::IntegerOverflowOverlay(unsigned width, unsigned height)
-: currentState(State::Inactive)
+IntegerOverflowOverlay::IntegerOverflowOverlay(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets)
+: targets(targets), m_size(width, height)
+, currentState(State::Inactive)
 , taskPassed(false)
 {
-    m_rt.create(width, height);
-    m_overlay.setTexture(m_rt.getTexture());
+    font = resources.font("assets/arial.ttf");
+
     setupBackground();
     setupUI();
 }
 
 void IntegerOverflowOverlay::setupBackground() {
-    backgroundGradient.setSize({(float)m_rt.getSize().x, (float)m_rt.getSize().y});
+    backgroundGradient.setSize({(float)m_size.x, (float)m_size.y});
     backgroundGradient.setPosition(0,0);
 
     backgroundCircles.clear();
@@ -28,15 +29,13 @@ void IntegerOverflowOverlay::setupBackground() {
 }
 
 void IntegerOverflowOverlay::setupUI() {
-    font.loadFromFile("assets/arial.ttf");
-
     // Title bar
-    titleBar.setSize({(float)m_rt.getSize().x,120.f});
+    titleBar.setSize({(float)m_size.x,120.f});
     titleBar.setPosition(0,0);
     titleBar.setFillColor(sf::Color(45,52,64,200));
 
     // Message
-    messageText.setFont(font);
+    messageText.setFont(*font);
     messageText.setString("Type as much as u can. I am bigger than ur thinking\n....Think bigger type bigger");
     messageText.setCharacterSize(24);
     messageText.setFillColor(sf::Color::White);
@@ -50,7 +49,7 @@ void IntegerOverflowOverlay::setupUI() {
     inputBox.setOutlineThickness(3);
     inputBox.setOutlineColor(sf::Color(76,175,80));
 
-    inputDisplayText.setFont(font);
+    inputDisplayText.setFont(*font);
     inputDisplayText.setCharacterSize(22);
     inputDisplayText.setFillColor(sf::Color(33,37,41));
     inputDisplayText.setPosition(210,293);
@@ -68,45 +67,45 @@ void IntegerOverflowOverlay::setupUI() {
     passwordBox.setOutlineThickness(3);
     passwordBox.setOutlineColor(sf::Color(33,150,243));
 
-    usernameLabel.setFont(font);
+    usernameLabel.setFont(*font);
     usernameLabel.setString("Username:");
     usernameLabel.setCharacterSize(20);
     usernameLabel.setFillColor(sf::Color::White);
     usernameLabel.setStyle(sf::Text::Bold);
     usernameLabel.setPosition(130,210);
 
-    usernameText.setFont(font);
+    usernameText.setFont(*font);
     usernameText.setString("Admin");
     usernameText.setCharacterSize(20);
     usernameText.setFillColor(sf::Color(33,37,41));
     usernameText.setPosition(250,210);
 
-    passwordLabel.setFont(font);
+    passwordLabel.setFont(*font);
     passwordLabel.setString("Password:");
     passwordLabel.setCharacterSize(20);
     passwordLabel.setFillColor(sf::Color::White);
     passwordLabel.setStyle(sf::Text::Bold);
     passwordLabel.setPosition(130,290);
 
-    passwordText.setFont(font);
+    passwordText.setFont(*font);
     passwordText.setString("9246890");
     passwordText.setCharacterSize(20);
     passwordText.setFillColor(sf::Color(33,37,41));
     passwordText.setPosition(250,290);
 
-    successMessage.setFont(font);
+    successMessage.setFont(*font);
     successMessage.setString("Task passed!!! Press Enter or ESC to exit.");
     successMessage.setCharacterSize(22);
     successMessage.setFillColor(sf::Color(76,175,80));
     successMessage.setStyle(sf::Text::Bold);
     successMessage.setPosition(120,370);
 
-    failureMessage.setFont(font);
+    failureMessage.setFont(*font);
     failureMessage.setString("Task failed!!!");
     failureMessage.setCharacterSize(24);
     failureMessage.setFillColor(sf::Color(244,67,54));
     failureMessage.setStyle(sf::Text::Bold);
-    float x = ((float)m_rt.getSize().x - failureMessage.getLocalBounds().width) / 2.f;
+    float x = ((float)m_size.x - failureMessage.getLocalBounds().width) / 2.f;
     failureMessage.setPosition(x,300);
 }
 
@@ -147,41 +146,44 @@ void IntegerOverflowOverlay::update(float) {}
 void IntegerOverflowOverlay::draw(sf::RenderWindow& window) {
     if (currentState == State::Inactive) return;
 
-    m_rt.clear();
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear();
     // draw gradient background
     sf::Vertex quad[] = {
         {{0,0}, sf::Color(67,56,202)},
-        {{(float)m_rt.getSize().x,0}, sf::Color(79,70,229)},
-        {{(float)m_rt.getSize().x,(float)m_rt.getSize().y}, sf::Color(99,102,241)},
-        {{0,(float)m_rt.getSize().y}, sf::Color(67,56,202)}
+        {{(float)rt.getSize().x,0}, sf::Color(79,70,229)},
+        {{(float)rt.getSize().x,(float)rt.getSize().y}, sf::Color(99,102,241)},
+        {{0,(float)rt.getSize().y}, sf::Color(67,56,202)}
     };
-    m_rt.draw(quad,4,sf::Quads);
-    for (auto& c : backgroundCircles) m_rt.draw(c);
+    rt.draw(quad,4,sf::Quads);
+    for (auto& c : backgroundCircles) rt.draw(c);
 
     if (currentState == State::InputPhase) {
-        m_rt.draw(titleBar);
-        m_rt.draw(messageText);
-        m_rt.draw(inputBox);
-        m_rt.draw(inputDisplayText);
+        rt.draw(titleBar);
+        rt.draw(messageText);
+        rt.draw(inputBox);
+        rt.draw(inputDisplayText);
     } else if (currentState == State::SuccessPhase) {
-        sf::RectangleShape ov({(float)m_rt.getSize().x,(float)m_rt.getSize().y});
-        ov.setFillColor(sf::Color(0,0,0,50)); m_rt.draw(ov);
-        for (auto& c : backgroundCircles) m_rt.draw(c);
-        m_rt.draw(usernameLabel);
-        m_rt.draw(usernameBox);
-        m_rt.draw(usernameText);
-        m_rt.draw(passwordLabel);
-        m_rt.draw(passwordBox);
-        m_rt.draw(passwordText);
-        m_rt.draw(successMessage);
+        sf::RectangleShape ov({(float)rt.getSize().x,(float)rt.getSize().y});
+        ov.setFillColor(sf::Color(0,0,0,50)); rt.draw(ov);
+        for (auto& c : backgroundCircles) rt.draw(c);
+        rt.draw(usernameLabel);
+        rt.draw(usernameBox);
+        rt.draw(usernameText);
+        rt.draw(passwordLabel);
+        rt.draw(passwordBox);
+        rt.draw(passwordText);
+        rt.draw(successMessage);
     } else {
-        sf::RectangleShape ov({(float)m_rt.getSize().x,(float)m_rt.getSize().y});
-        ov.setFillColor(sf::Color(0,0,0,50)); m_rt.draw(ov);
-        m_rt.draw(failureMessage);
+        sf::RectangleShape ov({(float)rt.getSize().x,(float)rt.getSize().y});
+        ov.setFillColor(sf::Color(0,0,0,50)); rt.draw(ov);
+        rt.draw(failureMessage);
     }
 
-    m_rt.display();
-    auto ws = window.getSize(); auto rs = m_rt.getSize();
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
+    auto ws = window.getSize(); auto rs = rt.getSize();
     m_overlay.setPosition((ws.x-rs.x)*0.5f,(ws.y-rs.y)*0.5f);
     window.draw(m_overlay);
 }
@@ -4,20 +4,24 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
-class IntegerOverflowOverlay {
+class IntegerOverflowOverlay : public TaskOverlay {
 public:
     enum class State { Inactive, InputPhase, SuccessPhase, FailurePhase };
 
-    IntegerOverflowOverlay(unsigned width, unsigned height);
+    IntegerOverflowOverlay(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets);
 
-    void start();
-    void handleEvent(const sf::Event& e);
-    void update(float dt);
-    void draw(sf::RenderWindow& window);
+    void start() override;
+    void handleEvent(const sf::Event& e) override;
+    void update(float dt) override;
+    void draw(sf::RenderWindow& window) override;
 
-    bool isActive() const;
-    bool isFinished() const;
+    bool isActive() const override;
+    bool isFinished() const override;
     bool passed() const;
 
 private:
@@ -27,9 +31,10 @@ private:
     bool isValidNumericInput(const std::string& s);
     bool isIntegerOverflow(const std::string& s);
 
-    sf::RenderTexture              m_rt;
+    RenderTargetPool&              targets;    // lends the off-screen target while drawing
+    sf::Vector2u                   m_size;
     sf::Sprite                     m_overlay;
-    sf::Font                       font;
+    std::shared_ptr<const sf::Font> font;
 
     State                          currentState;
     std::string                    inputText;
@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <memory>
+#include "tasks/TaskOverlay.hpp"
+
+// Holds a task overlay that is only built the first time it is started.
+// Overlays lay out dozens of texts and shapes when constructed, and most
+// runs open just a few of them. Until then it reads as inactive and
+// unfinished, and update() and draw() do nothing.
+template <class T>
+class LazyOverlay : public TaskOverlay {
+public:
+    explicit LazyOverlay(std::function<std::unique_ptr<T>()> factory)
+        : factory(std::move(factory)) {}
+
+    void start() override {
+        if (!overlay) overlay = factory();
+        overlay->start();
+    }
+
+    void handleEvent(const sf::Event& e) override { if (overlay) overlay->handleEvent(e); }
+    void update(float dt) override                { if (overlay) overlay->update(dt); }
+    void draw(sf::RenderWindow& window) override  { if (overlay) overlay->draw(window); }
+
+    bool isActive()   const override { return overlay && overlay->isActive(); }
+    bool isFinished() const override { return overlay && overlay->isFinished(); }
+    bool takesInput() const override { return overlay && overlay->takesInput(); }
+    bool isVisible()  const override { return overlay && overlay->isVisible(); }
+
+private:
+    std::function<std::unique_ptr<T>()> factory;
+    std::unique_ptr<T> overlay;
+};
+
+// Wraps a factory returning std::unique_ptr<T> without spelling out T
+template <class Factory>
+std::unique_ptr<TaskOverlay> makeLazyOverlay(Factory factory) {
+    using T = typename decltype(factory())::element_type;
+    return std::unique_ptr<TaskOverlay>(new LazyOverlay<T>(std::move(factory)));
+}
@@ -1,18 +1,13 @@
 #include "tasks/PCSimulatorOverlay.hpp"
 #include <iostream>
 
-PCSimulatorOverlay::PCSimulatorOverlay(unsigned width, unsigned height)
-: currentState(Inactive)
+PCSimulatorOverlay::PCSimulatorOverlay(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets)
+: targets(targets), m_size(width, height)
+, currentState(Inactive)
 , switchOn(false)
 , showInfoWindow(false)
 {
-    // Create off-screen render texture
-    m_rt.create(width, height);
-    m_overlay.setTexture(m_rt.getTexture());
-
-    if (!font.loadFromFile("assets/arial.ttf")) {
-        std::cerr << "Warning: could not load arial.ttf\n";
-    }
+    font = resources.font("assets/arial.ttf");
 
     setupUI();
 }
@@ -83,33 +78,36 @@ void PCSimulatorOverlay::draw(sf::RenderWindow& window) {
     if (currentState == Inactive)
         return;
 
-    m_rt.clear(sf::Color::Black);
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear(sf::Color::Black);
 
     if (currentState == WaitingFlip) {
-        m_rt.draw(switchMessage);
-        m_rt.draw(switchBackground);
-        m_rt.draw(switchToggle);
-        m_rt.draw(onText);
-        m_rt.draw(offText);
+        rt.draw(switchMessage);
+        rt.draw(switchBackground);
+        rt.draw(switchToggle);
+        rt.draw(onText);
+        rt.draw(offText);
     }
     else if (currentState == Info) {
-        m_rt.draw(infoWindow);
-        m_rt.draw(infoBox);
-        m_rt.draw(infoTitle);
-        m_rt.draw(usernameLabel);
-        m_rt.draw(usernameField);
-        m_rt.draw(usernameValue);
-        m_rt.draw(passwordLabel);
-        m_rt.draw(passwordField);
-        m_rt.draw(passwordValue);
-        m_rt.draw(exitMessage);
+        rt.draw(infoWindow);
+        rt.draw(infoBox);
+        rt.draw(infoTitle);
+        rt.draw(usernameLabel);
+        rt.draw(usernameField);
+        rt.draw(usernameValue);
+        rt.draw(passwordLabel);
+        rt.draw(passwordField);
+        rt.draw(passwordValue);
+        rt.draw(exitMessage);
     }
 
-    m_rt.display();
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
 
     // Center on main window
     auto ws = window.getSize();
-    auto rs = m_rt.getSize();
+    auto rs = rt.getSize();
     m_overlay.setPosition((ws.x - rs.x) * 0.5f,
                           (ws.y - rs.y) * 0.5f);
     window.draw(m_overlay);
@@ -125,7 +123,7 @@ bool PCSimulatorOverlay::isFinished() const {
 
 void PCSimulatorOverlay::setupUI() {
     // --- Switch UI ---
-    switchMessage.setFont(font);
+    switchMessage.setFont(*font);
     switchMessage.setString("Turn on the switch");
     switchMessage.setCharacterSize(24);
     switchMessage.setFillColor(sf::Color::White);
@@ -141,13 +139,13 @@ void PCSimulatorOverlay::setupUI() {
     switchToggle.setPosition(342.f,252.f);
     switchToggle.setFillColor(sf::Color::Red);
 
-    onText.setFont(font);
+    onText.setFont(*font);
     onText.setString("ON");
     onText.setCharacterSize(14);
     onText.setFillColor(sf::Color::White);
     onText.setPosition(420.f,270.f);
 
-    offText.setFont(font);
+    offText.setFont(*font);
     offText.setString("OFF");
     offText.setCharacterSize(14);
     offText.setFillColor(sf::Color::White);
@@ -166,13 +164,13 @@ void PCSimulatorOverlay::setupUI() {
     infoBox.setOutlineThickness(2.f);
     infoBox.setOutlineColor(sf::Color::Cyan);
 
-    infoTitle.setFont(font);
+    infoTitle.setFont(*font);
     infoTitle.setString("Here is the username and password of PC");
     infoTitle.setCharacterSize(22);
     infoTitle.setFillColor(sf::Color::White);
     infoTitle.setPosition(180.f,170.f);
 
-    usernameLabel.setFont(font);
+    usernameLabel.setFont(*font);
     usernameLabel.setString("Username:");
     usernameLabel.setCharacterSize(20);
     usernameLabel.setFillColor(sf::Color::White);
@@ -184,13 +182,13 @@ void PCSimulatorOverlay::setupUI() {
     usernameField.setOutlineThickness(2.f);
     usernameField.setOutlineColor(sf::Color::Black);
 
-    usernameValue.setFont(font);
+    usernameValue.setFont(*font);
     usernameValue.setString("student");
     usernameValue.setCharacterSize(18);
     usernameValue.setFillColor(sf::Color::Black);
     usernameValue.setPosition(210.f,270.f);
 
-    passwordLabel.setFont(font);
+    passwordLabel.setFont(*font);
     passwordLabel.setString("Password:");
     passwordLabel.setCharacterSize(20);
     passwordLabel.setFillColor(sf::Color::White);
@@ -202,13 +200,13 @@ void PCSimulatorOverlay::setupUI() {
     passwordField.setOutlineThickness(2.f);
     passwordField.setOutlineColor(sf::Color::Black);
 
-    passwordValue.setFont(font);
+    passwordValue.setFont(*font);
     passwordValue.setString("student");
     passwordValue.setCharacterSize(18);
     passwordValue.setFillColor(sf::Color::Black);
     passwordValue.setPosition(210.f,360.f);
 
-    exitMessage.setFont(font);
+    exitMessage.setFont(*font);
     exitMessage.setString("Press Enter or Escape to exit the task");
     exitMessage.setCharacterSize(18);
     exitMessage.setFillColor(sf::Color::Yellow);
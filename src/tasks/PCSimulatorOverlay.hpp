@@ -1,35 +1,40 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
-class PCSimulatorOverlay {
+class PCSimulatorOverlay : public TaskOverlay {
 public:
     enum State { Inactive, WaitingFlip, Info };
 
-    PCSimulatorOverlay(unsigned width, unsigned height);
+    PCSimulatorOverlay(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets);
 
     // Activate/reset overlay
-    void start();
+    void start() override;
 
     // Feed every SFML event here
-    void handleEvent(const sf::Event& e);
+    void handleEvent(const sf::Event& e) override;
 
     // Call once per frame (no-op)
-    void update(float dt);
+    void update(float dt) override;
 
     // Draw on top of your main window
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
 
     // Helpers for main loop
-    bool isActive()   const;
-    bool isFinished() const;
+    bool isActive()   const override;
+    bool isFinished() const override;
 
 private:
     void setupUI();
 
-    sf::RenderTexture    m_rt;
+    RenderTargetPool&    targets;    // lends the off-screen target while drawing
+    sf::Vector2u         m_size;
     sf::Sprite           m_overlay;
-    sf::Font             font;
+    std::shared_ptr<const sf::Font> font;
 
     State                currentState;
     bool                 switchOn;
@@ -5,15 +5,13 @@
 #include <sstream>
 #include <iomanip>
 
-PhotocopierTask::PhotocopierTask(unsigned w, unsigned h)
+PhotocopierTask::PhotocopierTask(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets)
 : state(State::Inactive)
+, targets(targets), m_size(w, h)
 {
     std::srand(unsigned(std::time(nullptr)));
-    m_rt.create(w, h);
-    m_overlay.setTexture(m_rt.getTexture());
-
     // Load font
-    font.loadFromFile("assets/arial.ttf");
+    font = resources.font("assets/arial.ttf");
 
     setupUI();
     // Don't call resetPages() here; leave Inactive until start()
@@ -46,7 +44,7 @@ void PhotocopierTask::setupUI() {
     copierSlot.setFillColor({50,50,50});
     copierSlot.setPosition(420,270);
 
-    copierLabel.setFont(font);
+    copierLabel.setFont(*font);
     copierLabel.setString("COPIER");
     copierLabel.setCharacterSize(16);
     copierLabel.setFillColor(sf::Color::White);
@@ -64,22 +62,22 @@ void PhotocopierTask::setupUI() {
     barFill.setPosition(barFrame.getPosition() + sf::Vector2f(2,2));
 
     // Instruction text
-    instrText.setFont(font);
+    instrText.setFont(*font);
     instrText.setCharacterSize(20);
     instrText.setFillColor(sf::Color::White);
     instrText.setPosition(300,150);
 
-    timerText.setFont(font);
+    timerText.setFont(*font);
     timerText.setCharacterSize(18);
     timerText.setFillColor(sf::Color::White);
     timerText.setPosition(620,450);
 
-    pageCountText.setFont(font);
+    pageCountText.setFont(*font);
     pageCountText.setCharacterSize(18);
     pageCountText.setFillColor(sf::Color::Cyan);
     pageCountText.setPosition(50,50);
 
-    completionText.setFont(font);
+    completionText.setFont(*font);
     completionText.setString("TASK COMPLETED!(4)");
     completionText.setCharacterSize(48);
     completionText.setFillColor(sf::Color::Green);
@@ -103,7 +101,7 @@ void PhotocopierTask::resetPages() {
         pages.push_back(pg);
 
         sf::Text label;
-        label.setFont(font);
+        label.setFont(*font);
         label.setString("Page " + std::to_string(i+1));
         label.setCharacterSize(14);
         label.setFillColor(sf::Color::White);
@@ -216,9 +214,9 @@ void PhotocopierTask::updateBackground(float dt) {
         auto pos = p.getPosition();
         pos.x += (30 + std::rand()%20)*dt;
         pos.y += std::sin(pos.x*0.01f)*20*dt;
-        if (pos.x > m_rt.getSize().x+20) {
+        if (pos.x > m_size.x+20) {
             pos.x = -20;
-            pos.y = std::rand()%m_rt.getSize().y;
+            pos.y = std::rand()%m_size.y;
         }
         p.setPosition(pos);
     }
@@ -226,15 +224,17 @@ void PhotocopierTask::updateBackground(float dt) {
 
 void PhotocopierTask::draw(sf::RenderWindow& window) {
     if (state == State::Inactive) return;
-    m_rt.clear({0,0,0,180});
-    for (auto& p : backgroundParticles) m_rt.draw(p);
-    m_rt.draw(copier);
-    m_rt.draw(copierSlot);
-    m_rt.draw(copierLabel);
-    for (auto& pg : pages) if (!pg.isProcessed || pg.isInCopier) m_rt.draw(pg.shape);
-    for (auto& pg : pages) if (pg.isProcessed && !pg.isInCopier) m_rt.draw(pg.shape);
-    for (int i = 0; i < (int)pageLabels.size(); ++i) if (!pages[i].isProcessed && !pages[i].isInCopier) m_rt.draw(pageLabels[i]);
-    m_rt.draw(barFrame); m_rt.draw(barFill);
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear({0,0,0,180});
+    for (auto& p : backgroundParticles) rt.draw(p);
+    rt.draw(copier);
+    rt.draw(copierSlot);
+    rt.draw(copierLabel);
+    for (auto& pg : pages) if (!pg.isProcessed || pg.isInCopier) rt.draw(pg.shape);
+    for (auto& pg : pages) if (pg.isProcessed && !pg.isInCopier) rt.draw(pg.shape);
+    for (int i = 0; i < (int)pageLabels.size(); ++i) if (!pages[i].isProcessed && !pages[i].isInCopier) rt.draw(pageLabels[i]);
+    rt.draw(barFrame); rt.draw(barFill);
     switch (state) {
         case State::WaitingForInsert:
             instrText.setString("Drag pages into copier slot  [" + std::to_string(pagesProcessed) + "/3]");
@@ -244,10 +244,11 @@ void PhotocopierTask::draw(sf::RenderWindow& window) {
         default: break;
     }
     pageCountText.setString("Pages Completed: " + std::to_string(pagesProcessed) + "/3");
-    m_rt.draw(instrText); m_rt.draw(timerText); m_rt.draw(pageCountText);
-    if (state == State::TaskCompleted) m_rt.draw(completionText);
-    m_rt.display();
-    auto ws = window.getSize(), rs = m_rt.getSize();
+    rt.draw(instrText); rt.draw(timerText); rt.draw(pageCountText);
+    if (state == State::TaskCompleted) rt.draw(completionText);
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
+    auto ws = window.getSize(), rs = rt.getSize();
     m_overlay.setPosition((ws.x-rs.x)*0.5f, (ws.y-rs.y)*0.5f);
     window.draw(m_overlay);
 }
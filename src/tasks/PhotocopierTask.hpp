@@ -2,27 +2,31 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
-class PhotocopierTask {
+class PhotocopierTask : public TaskOverlay {
 public:
     // w,h = overlay size
-    PhotocopierTask(unsigned w, unsigned h);
+    PhotocopierTask(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets);
 
     // Called when player clicks the button on a "photocopier" tile
-    void start();
+    void start() override;
 
     // Forward SFML events from your main loop
-    void handleEvent(const sf::Event& e);
+    void handleEvent(const sf::Event& e) override;
 
     // Update per-frame logic (background animation, printing progress)
-    void update(float dt);
+    void update(float dt) override;
 
     // Draw the overlay into your existing RenderWindow
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
 
     // Queries for your main loop
-    bool isActive()   const;  // overlay showing (either playing or completed)
-    bool isFinished() const;  // task done, waiting to be dismissed
+    bool isActive()   const override;  // overlay showing (either playing or completed)
+    bool isFinished() const override;  // task done, waiting to be dismissed
 
 private:
     enum class State {
@@ -35,11 +39,12 @@ private:
     State state;
 
     // Off-screen buffer + sprite
-    sf::RenderTexture    m_rt;
+    RenderTargetPool&    targets;    // lends the off-screen target while drawing
+    sf::Vector2u         m_size;
     sf::Sprite           m_overlay;
 
     // Shared font
-    sf::Font             font;
+    std::shared_ptr<const sf::Font> font;
 
     // Copier UI
     sf::RectangleShape   copier;
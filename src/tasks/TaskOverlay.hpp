@@ -0,0 +1,24 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// What the main loop needs from a task overlay. Only the running overlay
+// is driven each frame, so the defaults below describe when it keeps
+// input focus and when it is still on screen.
+class TaskOverlay {
+public:
+    virtual ~TaskOverlay() = default;
+
+    virtual void start() = 0;
+    virtual void handleEvent(const sf::Event& e) = 0;
+    virtual void update(float dt) = 0;
+    virtual void draw(sf::RenderWindow& window) = 0;
+
+    virtual bool isActive()   const = 0;   // blocks movement and the task button
+    virtual bool isFinished() const = 0;   // counts the task as done
+
+    // Events go to the overlay while this holds
+    virtual bool takesInput() const { return isActive(); }
+
+    // Drawn while this holds, e.g. to show a result after finishing
+    virtual bool isVisible() const { return isActive() || isFinished(); }
+};
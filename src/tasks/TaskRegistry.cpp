@@ -0,0 +1,18 @@
+#include "tasks/TaskRegistry.hpp"
+
+TaskOverlay& TaskRegistry::add(const std::string& type, std::unique_ptr<TaskOverlay> overlay) {
+    auto it = byType.find(type);
+    if (it != byType.end()) {
+        // Re-registering a type replaces its overlay in place
+        list[it->second].overlay = std::move(overlay);
+        return *list[it->second].overlay;
+    }
+    byType.emplace(type, list.size());
+    list.push_back({type, std::move(overlay)});
+    return *list.back().overlay;
+}
+
+TaskOverlay* TaskRegistry::find(const std::string& type) const {
+    auto it = byType.find(type);
+    return it != byType.end() ? list[it->second].overlay.get() : nullptr;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "tasks/TaskOverlay.hpp"
+
+// The task overlays keyed by the Tiled "type" string of their trigger
+// tiles ("cout", "wifioff", ...). Registration order is kept, and is the
+// order the map is scanned in when the player stands on several tasks.
+class TaskRegistry {
+public:
+    struct Entry {
+        std::string type;
+        std::unique_ptr<TaskOverlay> overlay;
+    };
+
+    TaskOverlay& add(const std::string& type, std::unique_ptr<TaskOverlay> overlay);
+
+    // nullptr if no overlay is registered for this type
+    TaskOverlay* find(const std::string& type) const;
+
+    const std::vector<Entry>& entries() const { return list; }
+    size_t size() const { return list.size(); }
+
+private:
+    std::vector<Entry> list;
+    std::unordered_map<std::string, size_t> byType;
+};
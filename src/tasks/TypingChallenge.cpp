@@ -5,26 +5,21 @@
 #include <cctype>
 #include <sstream>
 
-TypingChallenge::TypingChallenge(unsigned w, unsigned h)
+TypingChallenge::TypingChallenge(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets)
 : currentState(State::Inactive)
+, targets(targets), m_size(w, h)
 , autoClose(false)
 , taskPassed(false)
 , rng(std::random_device{}())
 {
-    // Create off-screen buffer
-    if (!m_rt.create(w, h))
-        std::cerr << "Error: cannot create TypingChallenge overlay\n";
-    m_overlay.setTexture(m_rt.getTexture());
+    font = resources.font("assets/arial.ttf");
+
     setupUI();
 }
 
 void TypingChallenge::setupUI() {
-    // Load font
-    if (!font.loadFromFile("assets/arial.ttf"))
-        std::cerr << "Warning: could not load arial.ttf\n";
-
     // Title
-    titleText.setFont(font);
+    titleText.setFont(*font);
     titleText.setString("Letter → Number Challenge");
     titleText.setCharacterSize(32);
     titleText.setFillColor(sf::Color::White);
@@ -33,7 +28,7 @@ void TypingChallenge::setupUI() {
     titleText.setPosition(20.f, 20.f);
 
     // Instructions
-    instructionText.setFont(font);
+    instructionText.setFont(*font);
     instructionText.setString(
         "Convert letters to A=1 … Z=26\n"
         "Type numbers separated by spaces, then press Enter"
@@ -45,7 +40,7 @@ void TypingChallenge::setupUI() {
     instructionText.setPosition(20.f, 80.f);
 
     // String to convert
-    stringText.setFont(font);
+    stringText.setFont(*font);
     stringText.setCharacterSize(36);
     stringText.setFillColor(sf::Color::Cyan);
     stringText.setOutlineColor(sf::Color::Black);
@@ -59,7 +54,7 @@ void TypingChallenge::setupUI() {
     inputBox.setOutlineThickness(2.f);
     inputBox.setOutlineColor(sf::Color::White);
 
-    inputText.setFont(font);
+    inputText.setFont(*font);
     inputText.setCharacterSize(22);
     inputText.setFillColor(sf::Color::White);
     inputText.setOutlineColor(sf::Color::Black);
@@ -67,14 +62,14 @@ void TypingChallenge::setupUI() {
     inputText.setPosition(25.f, 215.f);
 
     // Result message
-    resultText.setFont(font);
+    resultText.setFont(*font);
     resultText.setCharacterSize(28);
     resultText.setOutlineColor(sf::Color::Black);
     resultText.setOutlineThickness(2.f);
     resultText.setPosition(20.f, 300.f);
 
     // Exit prompt
-    exitText.setFont(font);
+    exitText.setFont(*font);
     exitText.setString("Press ESC to close");
     exitText.setCharacterSize(18);
     exitText.setFillColor(sf::Color::White);
@@ -170,22 +165,25 @@ void TypingChallenge::update(float) {
 void TypingChallenge::draw(sf::RenderWindow& window) {
     if (currentState == State::Inactive) return;
 
-    m_rt.clear({0,0,0,180});
-    m_rt.draw(titleText);
-    m_rt.draw(instructionText);
-    m_rt.draw(stringText);
-    m_rt.draw(inputBox);
-    m_rt.draw(inputText);
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear({0,0,0,180});
+    rt.draw(titleText);
+    rt.draw(instructionText);
+    rt.draw(stringText);
+    rt.draw(inputBox);
+    rt.draw(inputText);
 
     if (currentState == State::Completed) {
-        m_rt.draw(resultText);
-        m_rt.draw(exitText);
+        rt.draw(resultText);
+        rt.draw(exitText);
     }
 
-    m_rt.display();
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
 
     auto ws = window.getSize();
-    auto rs = m_rt.getSize();
+    auto rs = rt.getSize();
     m_overlay.setPosition(
         (ws.x - rs.x) * 0.5f,
         (ws.y - rs.y) * 0.5f
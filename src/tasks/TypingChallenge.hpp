@@ -4,39 +4,44 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <random>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
-class TypingChallenge {
+class TypingChallenge : public TaskOverlay {
 public:
     // w,h = overlay size
-    TypingChallenge(unsigned w, unsigned h);
+    TypingChallenge(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets);
 
     // Call when the player clicks the button on a "tyac" tile
-    void start();
+    void start() override;
 
     // Forward SFML events from your main loop
-    void handleEvent(const sf::Event& e);
+    void handleEvent(const sf::Event& e) override;
 
     // Update per-frame (auto-close after completion)
-    void update(float dt);
+    void update(float dt) override;
 
     // Draw into your existing RenderWindow
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
 
     // Overlay state queries
-    bool isActive()   const;  // true while playing
-    bool isFinished() const;  // true after completed, before close
-    bool passed()     const;  // did the player succeed?
+    bool isActive()   const override;  // true while playing
+    bool isFinished() const override;  // true after completed, before close
+    bool passed()     const;           // did the player succeed?
 
 private:
     enum class State { Inactive, Playing, Completed };
     State          currentState;
 
     // Off-screen buffer + sprite
-    sf::RenderTexture m_rt;
+    RenderTargetPool& targets;    // lends the off-screen target while drawing
+    sf::Vector2u      m_size;
     sf::Sprite        m_overlay;
 
     // Shared font + UI elements
-    sf::Font          font;
+    std::shared_ptr<const sf::Font> font;
     sf::Text          titleText;
     sf::Text          instructionText;
     sf::Text          stringText;
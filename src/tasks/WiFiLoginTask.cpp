@@ -3,16 +3,15 @@
 #include <algorithm>
 #include <cctype>
 
-WiFiLoginTask::WiFiLoginTask(unsigned width, unsigned height)
+WiFiLoginTask::WiFiLoginTask(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets)
 : state(State::Inactive)
 , w(width), h(height)
+, targets(targets)
 , userActive(false), passActive(false), showError(false)
 , rng(static_cast<unsigned>(std::time(nullptr)))
 , credIndex(0)
 {
-    rt.create(w, h);
-    overlay.setTexture(rt.getTexture());
-    font.loadFromFile("assets/arial.ttf"); // fallback if it fails
+    font = resources.font("assets/arial.ttf");
 
     generateCredentials();
     setupUI();
@@ -61,7 +60,7 @@ void WiFiLoginTask::nextCred() {
 
 void WiFiLoginTask::setupUI() {
     auto mkText = [&](sf::Text& t, const std::string& s, unsigned sz, float x, float y){
-        t.setFont(font);
+        t.setFont(*font);
         t.setString(s);
         t.setCharacterSize(sz);
         t.setFillColor(sf::Color::White);
@@ -211,6 +210,8 @@ void WiFiLoginTask::update(float /*dt*/) {
 void WiFiLoginTask::draw(sf::RenderWindow& window) {
     if (state == State::Inactive) return;
 
+    auto target = targets.acquire({w, h});
+    sf::RenderTexture& rt = *target;
     rt.clear({0,0,0,180});
 
     if (state == State::Login) {
@@ -241,6 +242,7 @@ void WiFiLoginTask::draw(sf::RenderWindow& window) {
     }
 
     rt.display();
+    overlay.setTexture(rt.getTexture(), true);
 
     auto ws  = window.getSize();
     auto rsz = rt.getSize();
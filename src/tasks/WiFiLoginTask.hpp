@@ -5,30 +5,34 @@
 #include <vector>
 #include <string>
 #include <random>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
 struct WiFiCredentials {
     std::string username;
     std::string password;
 };
 
-class WiFiLoginTask {
+class WiFiLoginTask : public TaskOverlay {
 public:
-    WiFiLoginTask(unsigned width, unsigned height);
+    WiFiLoginTask(unsigned width, unsigned height, ResourceCache& resources, RenderTargetPool& targets);
 
     // Trigger the login UI
-    void start();
+    void start() override;
 
     // Handle SFML events while active
-    void handleEvent(const sf::Event& e);
+    void handleEvent(const sf::Event& e) override;
 
     // Update per-frame (dt in seconds)
-    void update(float dt);
+    void update(float dt) override;
 
     // Draw the overlay
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
 
-    bool isActive()   const;
-    bool isFinished() const;
+    bool isActive()   const override;
+    bool isFinished() const override;
 
 private:
     enum class State { Inactive, Login, Info, Completed };
@@ -46,9 +50,9 @@ private:
     // Members
     State               state;
     unsigned            w, h;
-    sf::RenderTexture   rt;
+    RenderTargetPool&   targets;    // lends the off-screen target while drawing
     sf::Sprite          overlay;
-    sf::Font            font;
+    std::shared_ptr<const sf::Font> font;
 
     // Login screen
     sf::Text            header;
@@ -3,19 +3,12 @@
 #include <algorithm>
 #include <iostream>
 
-WiFiServerTask::WiFiServerTask(unsigned w, unsigned h)
+WiFiServerTask::WiFiServerTask(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets)
 : currentState(State::Inactive)
+, targets(targets), m_size(w, h)
 {
-    // Create off-screen buffer
-    if (!m_rt.create(w, h)) {
-        std::cerr << "Error: cannot create WiFi overlay of size "
-                  << w << "×" << h << "\n";
-    }
-    m_overlay.setTexture(m_rt.getTexture());
-
     // Load font
-    if (!font.loadFromFile("assets/arial.ttf"))
-        std::cerr << "Warning: could not load arial.ttf\n";
+    font = resources.font("assets/arial.ttf");
 
     initializeCredentials();
     initializeUI();
@@ -33,7 +26,7 @@ void WiFiServerTask::initializeCredentials() {
 
 void WiFiServerTask::initializeUI() {
     // Title
-    titleText.setFont(font);
+    titleText.setFont(*font);
     titleText.setString("WiFi Server Task");
     titleText.setCharacterSize(28);
     titleText.setFillColor(sf::Color::White);
@@ -51,7 +44,7 @@ void WiFiServerTask::initializeUI() {
     usernameBox.setOutlineThickness(2.f);
     usernameBox.setOutlineColor({100,149,237});
 
-    usernameInputText.setFont(font);
+    usernameInputText.setFont(*font);
     usernameInputText.setCharacterSize(18);
     usernameInputText.setFillColor(sf::Color::Black);
     usernameInputText.setPosition(55.f, 135.f);
@@ -74,7 +67,7 @@ void WiFiServerTask::initializeUI() {
     loginBtnBox.setOutlineThickness(2.f);
     loginBtnBox.setOutlineColor({255,255,255,150});
 
-    loginButtonText.setFont(font);
+    loginButtonText.setFont(*font);
     loginButtonText.setString("Login");
     loginButtonText.setCharacterSize(20);
     loginButtonText.setFillColor(sf::Color::White);
@@ -96,11 +89,11 @@ void WiFiServerTask::initializeUI() {
     offButtonText.setPosition(335.f, 135.f);
 
     // Result & exit prompt
-    resultText.setFont(font);
+    resultText.setFont(*font);
     resultText.setCharacterSize(24);
     resultText.setPosition(50.f, 200.f);
 
-    exitText.setFont(font);
+    exitText.setFont(*font);
     exitText.setString("Press Enter to continue");
     exitText.setCharacterSize(16);
     exitText.setFillColor(sf::Color::White);
@@ -225,6 +218,7 @@ void WiFiServerTask::handleEvent(const sf::Event& e) {
         if (e.type == sf::Event::KeyPressed &&
             e.key.code == sf::Keyboard::Enter)
         {
+            if (taskPassed) finished = true;
             currentState = State::Inactive;
         }
         break;
@@ -242,36 +236,39 @@ void WiFiServerTask::update(float) {
 void WiFiServerTask::draw(sf::RenderWindow& window) {
     if (currentState == State::Inactive) return;
 
-    // 1) Draw UI into m_rt
-    m_rt.clear({30,30,30,200});  // translucent background
+    // 1) Draw UI into a pooled target
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear({30,30,30,200});  // translucent background
 
-    m_rt.draw(titleText);
+    rt.draw(titleText);
     if (currentState == State::Login) {
-        m_rt.draw(usernameBox);
-        m_rt.draw(usernameLabel);
-        m_rt.draw(usernameInputText);
-        m_rt.draw(passwordBox);
-        m_rt.draw(passwordLabel);
-        m_rt.draw(passwordInputText);
-        m_rt.draw(loginBtnBox);
-        m_rt.draw(loginButtonText);
+        rt.draw(usernameBox);
+        rt.draw(usernameLabel);
+        rt.draw(usernameInputText);
+        rt.draw(passwordBox);
+        rt.draw(passwordLabel);
+        rt.draw(passwordInputText);
+        rt.draw(loginBtnBox);
+        rt.draw(loginButtonText);
     }
     else if (currentState == State::Option) {
-        m_rt.draw(onBtnBox);
-        m_rt.draw(onButtonText);
-        m_rt.draw(offBtnBox);
-        m_rt.draw(offButtonText);
+        rt.draw(onBtnBox);
+        rt.draw(onButtonText);
+        rt.draw(offBtnBox);
+        rt.draw(offButtonText);
     }
     else if (currentState == State::Result) {
-        m_rt.draw(resultText);
-        m_rt.draw(exitText);
+        rt.draw(resultText);
+        rt.draw(exitText);
     }
 
-    m_rt.display();
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
 
     // 2) Center it in the window
     auto ws = window.getSize();
-    auto rs = m_rt.getSize();
+    auto rs = rt.getSize();
     m_overlay.setPosition(
         float(ws.x - rs.x) * 0.5f,
         float(ws.y - rs.y) * 0.5f
@@ -286,5 +283,9 @@ bool WiFiServerTask::isActive() const {
 }
 
 bool WiFiServerTask::isFinished() const {
-    return currentState == State::Inactive;
+    return finished;
+}
+
+bool WiFiServerTask::isVisible() const {
+    return isActive();
 }
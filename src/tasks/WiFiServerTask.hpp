@@ -4,39 +4,46 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
-class WiFiServerTask {
+class WiFiServerTask : public TaskOverlay {
 public:
     // w,h = overlay size
-    WiFiServerTask(unsigned w, unsigned h);
+    WiFiServerTask(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets);
 
     // Kick off the overlay (called from your main task-dispatch)
-    void start();
+    void start() override;
 
     // Forward SFML events from your main loop
-    void handleEvent(const sf::Event& e);
+    void handleEvent(const sf::Event& e) override;
 
     // Update per-frame logic (animations, timers)
-    void update(float dt);
+    void update(float dt) override;
 
     // Draw into your existing RenderWindow
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
 
     // Is the overlay currently shown?
-    bool isActive()   const;
-    // Has the overlay finished (and dismissed itself)?
-    bool isFinished() const;
+    bool isActive()   const override;
+    // Has the player passed the task and dismissed the result?
+    bool isFinished() const override;
+    // Nothing is left to show once finished
+    bool isVisible()  const override;
 
 private:
     enum class State { Inactive, Login, Option, Result };
     State currentState;
 
     // Off-screen buffer & sprite for centering
-    sf::RenderTexture m_rt;
+    RenderTargetPool& targets;    // lends the off-screen target while drawing
+    sf::Vector2u      m_size;
     sf::Sprite        m_overlay;
 
     // Shared UI resources
-    sf::Font font;
+    std::shared_ptr<const sf::Font> font;
 
     // Text elements
     sf::Text titleText;
@@ -61,6 +68,7 @@ private:
     std::vector<std::string> validUsernames;
     std::vector<std::string> validPasswords;
     bool taskPassed = false;
+    bool finished = false;      // set once a passed result is dismissed
 
     // Helpers
     void initializeCredentials();
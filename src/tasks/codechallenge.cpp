@@ -2,17 +2,14 @@
 #include "tasks/codechallenge.h"
 #include <iostream>
 
-CodeChallenge::CodeChallenge(unsigned w, unsigned h)
-: m_rt(), currentState(CHALLENGE_INACTIVE), attemptsLeft(2), shouldAutoClose(false), gameWon(false),
+CodeChallenge::CodeChallenge(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets)
+: targets(targets), m_size(w, h), currentState(CHALLENGE_INACTIVE), attemptsLeft(2), shouldAutoClose(false), gameWon(false),
   correctAnswer("7.6"),
   backgroundColor(40, 44, 52), primaryColor(97, 218, 251), successColor(152, 195, 121),
   errorColor(224, 108, 117), codeBackgroundColor(30, 34, 40)
 {
-    // Prepare off-screen buffer
-    if (!m_rt.create(w, h)) {
-        std::cerr << "Error: Failed to create render texture for CodeChallenge overlay.\n";
-    }
-    m_overlay.setTexture(m_rt.getTexture());
+    font = resources.font("assets/arial.ttf");
+
     // Initial position; will be centered each draw
     m_overlay.setPosition(0.f, 0.f);
 
@@ -76,33 +73,36 @@ void CodeChallenge::draw(sf::RenderWindow& window) {
     if (currentState == CHALLENGE_INACTIVE) return;
 
     // Clear and draw UI into the off-screen buffer
-    m_rt.clear(backgroundColor);
-    m_rt.draw(codeBackground);
-    m_rt.draw(inputBackground);
-    m_rt.draw(titleText);
-    m_rt.draw(instructionText);
-    m_rt.draw(codeText);
-    m_rt.draw(inputPromptText);
-    m_rt.draw(userInputText);
-    m_rt.draw(attemptsText);
-    m_rt.draw(resultText);
-    m_rt.draw(correctAnswerText);
+    auto target = targets.acquire(m_size);
+    sf::RenderTexture& rt = *target;
+    rt.clear(backgroundColor);
+    rt.draw(codeBackground);
+    rt.draw(inputBackground);
+    rt.draw(titleText);
+    rt.draw(instructionText);
+    rt.draw(codeText);
+    rt.draw(inputPromptText);
+    rt.draw(userInputText);
+    rt.draw(attemptsText);
+    rt.draw(resultText);
+    rt.draw(correctAnswerText);
 
     if (shouldAutoClose) {
         sf::Text autoCloseText;
-        autoCloseText.setFont(font);
+        autoCloseText.setFont(*font);
         autoCloseText.setString("Window will auto-close in 2 seconds...");
         autoCloseText.setCharacterSize(16);
         autoCloseText.setFillColor(sf::Color::White);
-        autoCloseText.setPosition(20.f, m_rt.getSize().y - 30.f);
-        m_rt.draw(autoCloseText);
+        autoCloseText.setPosition(20.f, rt.getSize().y - 30.f);
+        rt.draw(autoCloseText);
     }
 
-    m_rt.display();
+    rt.display();
+    m_overlay.setTexture(rt.getTexture(), true);
 
     // Center the overlay on the window
     sf::Vector2u winSize = window.getSize();
-    sf::Vector2u rtSize  = m_rt.getSize();
+    sf::Vector2u rtSize  = rt.getSize();
     m_overlay.setPosition(
         (winSize.x - rtSize.x) * 0.5f,
         (winSize.y - rtSize.y) * 0.5f
@@ -120,42 +120,41 @@ bool CodeChallenge::isActive() const {
     return currentState == CHALLENGE_ACTIVE;
 }
 
-void CodeChallenge::initializeUI() {
-    // Load font
-    if (!font.loadFromFile("assets/arial.ttf")) {
-        std::cerr << "Warning: Could not load arial.ttf\n";
-    }
+bool CodeChallenge::isVisible() const {
+    return isActive();
+}
 
+void CodeChallenge::initializeUI() {
     // Title
-    titleText.setFont(font);
+    titleText.setFont(*font);
     titleText.setString("C++ Code Output Challenge");
     titleText.setCharacterSize(24);
     titleText.setFillColor(primaryColor);
     titleText.setPosition(20.f, 20.f);
 
     // Instructions
-    instructionText.setFont(font);
+    instructionText.setFont(*font);
     instructionText.setString("Guess the output. 2 attempts!");
     instructionText.setCharacterSize(16);
     instructionText.setFillColor(sf::Color::White);
     instructionText.setPosition(20.f, 60.f);
 
     // Code display
-    codeText.setFont(font);
+    codeText.setFont(*font);
     codeText.setString(challengeCode);
     codeText.setCharacterSize(12);
     codeText.setFillColor(sf::Color(171,178,191));
     codeText.setPosition(20.f, 100.f);
 
     // Code background
-    codeBackground.setSize(sf::Vector2f(m_rt.getSize().x - 40.f, 200.f));
+    codeBackground.setSize(sf::Vector2f(m_size.x - 40.f, 200.f));
     codeBackground.setPosition(20.f, 90.f);
     codeBackground.setFillColor(codeBackgroundColor);
     codeBackground.setOutlineThickness(2.f);
     codeBackground.setOutlineColor(primaryColor);
 
     // Input prompt
-    inputPromptText.setFont(font);
+    inputPromptText.setFont(*font);
     inputPromptText.setString("Enter your answer:");
     inputPromptText.setCharacterSize(16);
     inputPromptText.setFillColor(sf::Color::White);
@@ -169,7 +168,7 @@ void CodeChallenge::initializeUI() {
     inputBackground.setOutlineColor(primaryColor);
 
     // User input display
-    userInputText.setFont(font);
+    userInputText.setFont(*font);
     userInputText.setCharacterSize(16);
     userInputText.setFillColor(sf::Color::White);
     userInputText.setPosition(
@@ -179,19 +178,19 @@ void CodeChallenge::initializeUI() {
     userInputText.setString("_");
 
     // Attempts text
-    attemptsText.setFont(font);
+    attemptsText.setFont(*font);
     attemptsText.setCharacterSize(14);
     attemptsText.setFillColor(sf::Color::Yellow);
     attemptsText.setPosition(20.f, 350.f);
     updateAttemptsText();
 
     // Result text
-    resultText.setFont(font);
+    resultText.setFont(*font);
     resultText.setCharacterSize(18);
     resultText.setPosition(20.f, 380.f);
 
     // Correct answer text
-    correctAnswerText.setFont(font);
+    correctAnswerText.setFont(*font);
     correctAnswerText.setCharacterSize(16);
     correctAnswerText.setPosition(20.f, 420.f);
 }
@@ -2,6 +2,10 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <string>
+#include <memory>
+#include "core/ResourceCache.h"
+#include "ui/RenderTargetPool.h"
+#include "tasks/TaskOverlay.hpp"
 
 // Challenge states
 enum GameState {
@@ -10,34 +14,37 @@ enum GameState {
     CHALLENGE_FINISHED
 };
 
-class CodeChallenge {
+class CodeChallenge : public TaskOverlay {
 public:
     // w,h: size of the overlay render texture
-    CodeChallenge(unsigned w, unsigned h);
+    CodeChallenge(unsigned w, unsigned h, ResourceCache& resources, RenderTargetPool& targets);
 
     // Start or restart the challenge
-    void start();
+    void start() override;
 
     // Handle SFML events when the challenge is active
-    void handleEvent(const sf::Event& evt);
+    void handleEvent(const sf::Event& evt) override;
 
     // Advance logic by dt seconds
-    void update(float dt);
+    void update(float dt) override;
 
     // Draw the overlay onto the given window (centered)
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderWindow& window) override;
 
     // Query whether the challenge just finished
-    bool isFinished() const;
-    bool isActive()   const;
+    bool isFinished() const override;
+    bool isActive()   const override;
+    // Closes as soon as it finishes
+    bool isVisible()  const override;
 
 private:
     // Off-screen buffer and its sprite
-    sf::RenderTexture m_rt;
+    RenderTargetPool& targets;    // lends the off-screen target while drawing
+    sf::Vector2u      m_size;
     sf::Sprite        m_overlay;
 
     // UI resources
-    sf::Font          font;
+    std::shared_ptr<const sf::Font> font;
     sf::Text          titleText;
     sf::Text          instructionText;
     sf::Text          codeText;
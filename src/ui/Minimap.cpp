@@ -2,12 +2,22 @@
 // Minimap.cpp
 #include "ui/Minimap.h"
 
-Minimap::Minimap(float w, float h, sf::Font& font)
+Minimap::Minimap(float w, float h, const sf::Font& font)
 : worldW(w), worldH(h), fontPtr(&font)
 {
     // Set up view for full-world draw in top-right corner
     miniView = sf::View({0.f, 0.f, worldW, worldH});
     miniView.setViewport({0.75f, 0.f, 0.25f, 0.25f});
+
+    btnBg.setSize({buttonWidth, buttonHeight});
+    btnBg.setFillColor({0,0,0,180});
+    btnBg.setOutlineColor(sf::Color::White);
+    btnBg.setOutlineThickness(1.f);
+
+    btnText.setString("Map");
+    btnText.setFont(*fontPtr);
+    btnText.setCharacterSize(14);
+    btnText.setFillColor(sf::Color::White);
 }
 
 void Minimap::handleEvent(const sf::Event& event, sf::RenderWindow& window)
@@ -29,21 +39,14 @@ void Minimap::handleEvent(const sf::Event& event, sf::RenderWindow& window)
 void Minimap::draw(sf::RenderWindow& window,
                    const MapLoader& map,
                    const std::vector<sf::RectangleShape>& walls,
-                   Player& player,
+                   const sf::Sprite& playerSprite,
                    Enemy& enemy)
 {
     // 1) Draw the Map button
     auto sz = window.getSize();
-    sf::RectangleShape btnBg({buttonWidth, buttonHeight});
     btnBg.setPosition(sz.x - buttonWidth - buttonPadding, buttonPadding);
-    btnBg.setFillColor({0,0,0,180});
-    btnBg.setOutlineColor(sf::Color::White);
-    btnBg.setOutlineThickness(1.f);
     window.draw(btnBg);
 
-    sf::Text btnText("Map", *fontPtr);
-    btnText.setCharacterSize(14);
-    btnText.setFillColor(sf::Color::White);
     auto tb = btnText.getLocalBounds();
     btnText.setPosition(
         btnBg.getPosition().x + (buttonWidth - tb.width) / 2.f - tb.left,
@@ -53,21 +56,31 @@ void Minimap::draw(sf::RenderWindow& window,
 
     if (!open) return;
 
-    // 2) Draw textured map + optional walls under miniView
-    window.setView(miniView);
-    window.draw(map);
-    for (const auto& w : walls) window.draw(w);
-    window.draw(enemy.shape());
-    player.draw(window);
-
-    // 3) Overlay fixed-size markers in pixel coords
-    window.setView(window.getDefaultView());
+    // 2) Blit the cached map + walls, then the moving sprites under miniView
     auto vp = miniView.getViewport();
     float left   = vp.left   * sz.x;
     float top    = vp.top    * sz.y;
     float width  = vp.width  * sz.x;
     float height = vp.height * sz.y;
 
+    sf::Vector2u layerSize(unsigned(width), unsigned(height));
+    if (layerSize != staticSize) renderStatic(map, walls, layerSize);
+
+    window.setView(window.getDefaultView());
+    if (layerSize.x > 0 && layerSize.y > 0 && staticLayer.getSize() == layerSize) {
+        sf::Sprite layer(staticLayer.getTexture());
+        layer.setPosition(left, top);
+        layer.setScale(width / layerSize.x, height / layerSize.y);
+        window.draw(layer);
+    }
+
+    window.setView(miniView);
+    window.draw(enemy.shape());
+    window.draw(playerSprite);
+
+    // 3) Overlay fixed-size markers in pixel coords
+    window.setView(window.getDefaultView());
+
     auto toPixel = [&](const sf::Vector2f& p){
         return sf::Vector2f(
             left + (p.x / worldW) * width,
@@ -78,7 +91,7 @@ void Minimap::draw(sf::RenderWindow& window,
     sf::CircleShape dot(markerRadius);
     dot.setOrigin(markerRadius, markerRadius);
     dot.setFillColor(sf::Color::Green);
-    dot.setPosition(toPixel(player.getPosition()));
+    dot.setPosition(toPixel(playerSprite.getPosition()));
     window.draw(dot);
 
     dot.setFillColor(sf::Color::Red);
@@ -93,3 +106,17 @@ void Minimap::draw(sf::RenderWindow& window,
     frame.setOutlineThickness(2.f);
     window.draw(frame);
 }
+
+void Minimap::renderStatic(const MapLoader& map,
+                           const std::vector<sf::RectangleShape>& walls,
+                           sf::Vector2u size)
+{
+    staticSize = size;
+    if (size.x == 0 || size.y == 0 || !staticLayer.create(size.x, size.y))
+        return;
+    staticLayer.setView(sf::View({0.f, 0.f, worldW, worldH}));
+    staticLayer.clear(sf::Color::Transparent);
+    staticLayer.draw(map);
+    for (const auto& w : walls) staticLayer.draw(w);
+    staticLayer.display();
+}
@@ -2,7 +2,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "world/MapLoader.hpp"
-#include "entities/Player.h"
 #include "entities/Enemy.h"
 #include <vector>
 
@@ -10,16 +9,18 @@ class Minimap {
 public:
     // worldW/worldH: dimensions of full map
     // font: to render the Map toggle button
-    Minimap(float worldW, float worldH, sf::Font& font);
+    Minimap(float worldW, float worldH, const sf::Font& font);
 
     // Process click events for the Map button
     void handleEvent(const sf::Event& event, sf::RenderWindow& window);
 
-    // Draws the button, and if open, the minimap
+    // Draws the button, and if open, the minimap. The map and walls never
+    // change, so they are rendered once into a texture at minimap size and
+    // only the player and guard are drawn over it each frame.
     void draw(sf::RenderWindow& window,
               const MapLoader& map,
               const std::vector<sf::RectangleShape>& walls,
-              Player& player,
+              const sf::Sprite& playerSprite,
               Enemy& enemy);
 
 private:
@@ -27,9 +28,20 @@ private:
     float worldW;
     float worldH;
     sf::View miniView;
-    sf::Font* fontPtr;
+    const sf::Font* fontPtr;
     float markerRadius = 8.f;
     float buttonWidth = 60.f;
     float buttonHeight = 24.f;
     float buttonPadding = 8.f;
+
+    sf::RectangleShape btnBg;
+    sf::Text btnText;
+
+    // Map and walls at minimap resolution; redrawn when the window resizes
+    sf::RenderTexture staticLayer;
+    sf::Vector2u staticSize;
+
+    void renderStatic(const MapLoader& map,
+                      const std::vector<sf::RectangleShape>& walls,
+                      sf::Vector2u size);
 };
\ No newline at end of file
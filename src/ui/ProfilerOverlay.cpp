@@ -0,0 +1,100 @@
+#include "ui/ProfilerOverlay.h"
+#include <algorithm>
+#include <cstdio>
+
+static const sf::Color STAGE_COLORS[] = {
+    {230, 25, 75}, {60, 180, 75}, {255, 225, 25}, {0, 130, 200}, {245, 130, 48},
+    {145, 30, 180}, {70, 240, 240}, {240, 50, 230}, {210, 245, 60}, {250, 190, 212},
+};
+static const size_t COLOR_COUNT = sizeof(STAGE_COLORS) / sizeof(STAGE_COLORS[0]);
+
+ProfilerOverlay::ProfilerOverlay(const sf::Font& font)
+    : fontPtr(&font), history(HISTORY)
+{
+}
+
+void ProfilerOverlay::toggle() {
+    visible = !visible;
+}
+
+bool ProfilerOverlay::isVisible() const {
+    return visible;
+}
+
+size_t ProfilerOverlay::stageIndex(const char* name) {
+    for (size_t i = 0; i < names.size(); ++i)
+        if (names[i] == name) return i;
+    names.push_back(name);
+    return names.size() - 1;
+}
+
+void ProfilerOverlay::update() {
+    Profiler& p = Profiler::get();
+    if (p.getFrame() == 0) return;
+    p.collect(p.getFrame() - 1, scratch);
+    history[next].assign(scratch.begin(), scratch.end());
+    next = (next + 1) % HISTORY;
+}
+
+void ProfilerOverlay::draw(sf::RenderWindow& window) {
+    if (!visible) return;
+
+    const float barW = 2.f, graphW = HISTORY * barW, graphH = 120.f;
+    const float pad = 8.f, legendW = 190.f;
+    float left = pad, top = window.getSize().y - graphH - 3 * pad;
+    float pxPerMs = graphH / GRAPH_MS;
+
+    sf::RectangleShape bg({graphW + legendW + 3 * pad, graphH + 2 * pad});
+    bg.setPosition(left, top);
+    bg.setFillColor({0, 0, 0, 200});
+    window.draw(bg);
+
+    // One quad per stage per frame, oldest frame on the left
+    float gx = left + pad, gy = top + pad + graphH;
+    sf::VertexArray bars(sf::Quads);
+    for (int f = 0; f < HISTORY; ++f) {
+        const auto& stages = history[(next + f) % HISTORY];
+        float x = gx + f * barW, y = gy;
+        for (auto& s : stages) {
+            float h = std::min(s.duration / 1e6f * pxPerMs, y - (gy - graphH));
+            sf::Color c = STAGE_COLORS[stageIndex(s.name) % COLOR_COUNT];
+            bars.append({{x, y}, c});
+            bars.append({{x + barW, y}, c});
+            bars.append({{x + barW, y - h}, c});
+            bars.append({{x, y - h}, c});
+            y -= h;
+        }
+    }
+    window.draw(bars);
+
+    // 16.6 ms budget line
+    sf::RectangleShape budget({graphW, 1.f});
+    budget.setPosition(gx, gy - graphH / 2);
+    budget.setFillColor({255, 255, 255, 160});
+    window.draw(budget);
+
+    // Legend: the newest frame's time per stage
+    const auto& last = history[(next + HISTORY - 1) % HISTORY];
+    sf::Text label("", *fontPtr, 12);
+    label.setFillColor(sf::Color::White);
+    float lx = gx + graphW + pad, ly = top + pad;
+    float totalMs = 0.f;
+    char buf[64];
+    for (auto& s : last) {
+        float ms = s.duration / 1e6f;
+        totalMs += ms;
+        sf::RectangleShape swatch({10.f, 10.f});
+        swatch.setPosition(lx, ly + 2.f);
+        swatch.setFillColor(STAGE_COLORS[stageIndex(s.name) % COLOR_COUNT]);
+        window.draw(swatch);
+        std::snprintf(buf, sizeof(buf), "%-14s %6.2f ms", s.name, ms);
+        label.setString(buf);
+        label.setPosition(lx + 14.f, ly);
+        window.draw(label);
+        ly += 14.f;
+    }
+    std::snprintf(buf, sizeof(buf), "total %.2f ms  [F4: trace]", totalMs);
+    label.setString(buf);
+    label.setPosition(lx, ly + 4.f);
+    window.draw(label);
+}
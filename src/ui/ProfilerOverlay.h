@@ -0,0 +1,34 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "core/Profiler.h"
+
+// On-screen stacked bar graph of the frame stages, one bar per frame,
+// with a legend showing each stage's time in the last frame. Toggled
+// from the game loop; kept up to date even while hidden so the graph is
+// full when it opens.
+class ProfilerOverlay {
+public:
+    explicit ProfilerOverlay(const sf::Font& font);
+
+    void toggle();
+    bool isVisible() const;
+
+    // Takes the stages of the last finished frame; call once per frame
+    void update();
+    void draw(sf::RenderWindow& window);
+
+private:
+    static constexpr int HISTORY = 120;             // frames shown
+    static constexpr float GRAPH_MS = 1000.f / 30;   // graph height in ms; the midline is 60 fps
+
+    const sf::Font* fontPtr;
+    bool visible = false;
+
+    std::vector<std::vector<Profiler::Sample>> history;    // ring of HISTORY frames
+    size_t next = 0;
+    std::vector<Profiler::Sample> scratch;
+    std::vector<std::string> names;     // stages in order of first appearance, for colours
+
+    size_t stageIndex(const char* name);
+};
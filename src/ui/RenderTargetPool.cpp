@@ -0,0 +1,46 @@
+#include "ui/RenderTargetPool.h"
+#include <iostream>
+
+RenderTargetPool::Lease::Lease(RenderTargetPool& p, size_t s)
+    : pool(&p), slot(s)
+{
+}
+
+RenderTargetPool::Lease::Lease(Lease&& other) noexcept
+    : pool(other.pool), slot(other.slot)
+{
+    other.pool = nullptr;
+}
+
+RenderTargetPool::Lease::~Lease() {
+    if (pool) pool->slots[slot].inUse = false;
+}
+
+sf::RenderTexture& RenderTargetPool::Lease::operator*() const {
+    return *pool->slots[slot].target;
+}
+
+sf::RenderTexture* RenderTargetPool::Lease::operator->() const {
+    return pool->slots[slot].target.get();
+}
+
+RenderTargetPool::Lease RenderTargetPool::acquire(sf::Vector2u size) {
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (!slots[i].inUse && slots[i].target->getSize() == size) {
+            slots[i].inUse = true;
+            return Lease(*this, i);
+        }
+    }
+
+    Slot s;
+    s.target.reset(new sf::RenderTexture);
+    if (!s.target->create(size.x, size.y))
+        std::cerr << "Error: cannot create " << size.x << "x" << size.y << " overlay target\n";
+    s.inUse = true;
+    slots.push_back(std::move(s));
+    return Lease(*this, slots.size() - 1);
+}
+
+size_t RenderTargetPool::size() const {
+    return slots.size();
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+// Off-screen targets lent to the task overlays. Each overlay clears and
+// redraws its whole frame inside draw(), so it only needs a target for
+// the length of that call. With one overlay open at a time, the pool
+// usually holds a single texture instead of one per overlay.
+class RenderTargetPool {
+public:
+    // Returns the target to the pool when destroyed
+    class Lease {
+    public:
+        Lease(RenderTargetPool& pool, size_t slot);
+        Lease(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease();
+
+        sf::RenderTexture& operator*() const;
+        sf::RenderTexture* operator->() const;
+
+    private:
+        RenderTargetPool* pool;
+        size_t slot;
+    };
+
+    // A free target of exactly this size, created on first demand
+    Lease acquire(sf::Vector2u size);
+
+    size_t size() const;    // targets created so far
+
+private:
+    struct Slot {
+        std::unique_ptr<sf::RenderTexture> target;
+        bool inUse = false;
+    };
+    std::vector<Slot> slots;
+};
@@ -2,29 +2,22 @@
 #include "core/Constants.h"
 #include <cmath>
 
-static float intersectRaySegment(const sf::Vector2f& rayO, const sf::Vector2f& rayD,
-                                 const sf::Vector2f& A, const sf::Vector2f& B)
-{
-    sf::Vector2f v1 = rayO - A;
-    sf::Vector2f v2 = B - A;
-    sf::Vector2f v3(-rayD.y, rayD.x);
-    float dot = v2.x * v3.x + v2.y * v3.y;
-    if (std::fabs(dot) < 1e-6f) return INFINITY;
-    float t1 = (v2.x * v1.y - v2.y * v1.x) / dot;
-    float t2 = (v1.x * v3.x + v1.y * v3.y) / dot;
-    if (t1 >= 0.0f && t2 >= 0.0f && t2 <= 1.0f) {
-        return t1;
-    }
-    return INFINITY;
-}
-
 void updateView(sf::View& view, const Player& player) {
     sf::FloatRect pb = player.getGlobalBounds();
     view.setCenter(player.getPosition() + sf::Vector2f(pb.width, pb.height) / 2.f);
 }
 
+sf::Vector2f readMoveInput() {
+    sf::Vector2f movement(0.f, 0.f);
+    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Left))  movement.x -= 1.f;
+    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) movement.x += 1.f;
+    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Up))    movement.y -= 1.f;
+    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Down))  movement.y += 1.f;
+    return movement;
+}
+
 void drawScene(sf::RenderWindow& window,
-               const std::vector<sf::RectangleShape>& walls, 
+               const VisibilityPolygon& light,
                Enemy& enemy,
                Player& player,
                const sf::Text& scoreText)
@@ -32,37 +25,14 @@ void drawScene(sf::RenderWindow& window,
     // for (auto& w : walls) window.draw(w);
     // window.draw(zone);
 
-    const int RAY_COUNT = 15;
+    // Outline of the lit area, closed back onto its first point
     std::vector<sf::Vertex> vertices;
-    vertices.reserve(RAY_COUNT + 2);
-    sf::Vector2f center = enemy.shape().getPosition();
-    vertices.push_back(sf::Vertex(center, LIGHT_COLOR));
-
-    for (int i = 0; i <= RAY_COUNT; ++i) {
-        float angle = (2 * 3.14159265f * i) / RAY_COUNT;
-        sf::Vector2f dir(std::cos(angle), std::sin(angle));
-        sf::Vector2f farPoint = center + dir * LIGHT_RADIUS;
-
-        float minT = LIGHT_RADIUS;
-        for (auto& w : walls) {
-            sf::FloatRect rect = w.getGlobalBounds();
-            sf::Vector2f p1(rect.left, rect.top);
-            sf::Vector2f p2(rect.left + rect.width, rect.top);
-            sf::Vector2f p3(rect.left + rect.width, rect.top + rect.height);
-            sf::Vector2f p4(rect.left, rect.top + rect.height);
-            float t;
-            t = intersectRaySegment(center, dir, p1, p2);
-            if (t < minT) minT = t;
-            t = intersectRaySegment(center, dir, p2, p3);
-            if (t < minT) minT = t;
-            t = intersectRaySegment(center, dir, p3, p4);
-            if (t < minT) minT = t;
-            t = intersectRaySegment(center, dir, p4, p1);
-            if (t < minT) minT = t;
-        }
-        sf::Vector2f finalPoint = center + dir * minT;
-        vertices.push_back(sf::Vertex(finalPoint, LIGHT_COLOR));
-    }
+    vertices.reserve(light.points.size() + 2);
+    vertices.push_back(sf::Vertex(light.origin, LIGHT_COLOR));
+    for (auto& p : light.points)
+        vertices.push_back(sf::Vertex(p, LIGHT_COLOR));
+    if (!light.points.empty())
+        vertices.push_back(sf::Vertex(light.points.front(), LIGHT_COLOR));
 
     sf::VertexArray lightFan(sf::TriangleFan, vertices.size());
     for (size_t i = 0; i < vertices.size(); ++i) {
@@ -2,10 +2,13 @@
 #include <SFML/Graphics.hpp>
 #include "entities/Player.h"
 #include "entities/Enemy.h"
+#include "world/VisibilityCaster.h"
 
 void updateView(sf::View& view, const Player& player);
+// Arrow-key direction for this frame, unnormalised; zero when none are held
+sf::Vector2f readMoveInput();
 void drawScene(sf::RenderWindow& window,
-               const std::vector<sf::RectangleShape>& walls,
+               const VisibilityPolygon& light,
                Enemy& enemy,
                Player& player,
                const sf::Text& scoreText);
@@ -1,36 +1,22 @@
 #include "ui/isend.h"
 #include "core/Constants.h"
+#include "world/LineOfSight.h"
 #include <cmath>
 
-static sf::FloatRect createLineAABB(const sf::Vector2f& p1,
-                                    const sf::Vector2f& p2,
-                                    float thickness = 2.f)
+bool isend(const OccupancyGrid& walls,
+           const VisibilityPolygon& light,
+           const sf::Vector2f& pos_player)
 {
-    float left   = std::min(p1.x, p2.x);
-    float top    = std::min(p1.y, p2.y) - thickness/2.f;
-    float width  = std::abs(p2.x - p1.x);
-    float height = std::abs(p2.y - p1.y) + thickness;
-
-    return { left, top, width, height };
-}
-
-bool isend(const std::vector<sf::RectangleShape>& walls,
-           const sf::Vector2f& pos_player,
-           const sf::Vector2f& pos_enemy)
-{
-    // Range check: if enemy >= 100 units away, never end the game
-    if (dist(pos_enemy, pos_player) >= 100.f)
+    // Range check: outside the light radius, never end the game
+    if (dist(light.origin, pos_player) >= LIGHT_RADIUS)
         return false;
 
-    bool wallBlocks = false;
-
-    // Obstacle check: build a thin AABB "line" between enemy and player
-    sf::FloatRect line = createLineAABB(pos_enemy, pos_player, 2.f);
-    for (auto& w : walls) {
-        if (line.intersects(w.getGlobalBounds()))
-            wallBlocks = true;
-    }
+    // Cheap early-out: a wall cell on the sight line hides the player
+    if (!hasLineOfSight(walls, TILE_SIZE, light.origin, pos_player))
+        return false;
 
-    // If no wall intersects the line, enemy has clear sight -> game over
-    return (!wallBlocks);
+    // The ray alone is not the drawn light: the light is a 32-gon inside the
+    // radius, and at wall corners the ray and the polygon outline can part.
+    // Only catch the player inside the lit area shown on screen.
+    return light.contains(pos_player);
 }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
-#include <vector>
+#include "world/OccupancyGrid.h"
+#include "world/VisibilityCaster.h"
 
-// Check if the game should end (enemy caught the player)
-bool isend(const std::vector<sf::RectangleShape>& walls,
-           const sf::Vector2f& pos_player,
-           const sf::Vector2f& pos_enemy);
+// Check if the game should end (enemy caught the player): the player stands
+// in the enemy's light as it is drawn. light is cast from the enemy over the
+// same walkable grid as walls.
+bool isend(const OccupancyGrid& walls,
+           const VisibilityPolygon& light,
+           const sf::Vector2f& pos_player);
@@ -0,0 +1,87 @@
+#include "world/AStar.h"
+#include <algorithm>
+#include <cstdlib>
+
+int gridHeuristic(Tile a, Tile b, Connectivity conn) {
+    int dx = std::abs(a.first - b.first);
+    int dy = std::abs(a.second - b.second);
+    if (conn == Connectivity::Four)
+        return STRAIGHT_COST * (dx + dy);
+    return STRAIGHT_COST * std::max(dx, dy) + (DIAGONAL_COST - STRAIGHT_COST) * std::min(dx, dy);
+}
+
+AStar::AStar(Connectivity c)
+    : conn(c)
+{
+}
+
+size_t AStar::lastExpanded() const {
+    return expanded;
+}
+
+std::vector<Tile> AStar::findPath(Tile start, Tile goal, const OccupancyGrid& coarseGrid) {
+    int cols = coarseGrid.getCols();
+    int rows = coarseGrid.getRows();
+    auto inb = [&](int x, int y) { return x >= 0 && x < cols && y >= 0 && y < rows; };
+
+    int sx = start.first, sy = start.second;
+    int gx = goal.first, gy = goal.second;
+    expanded = 0;
+
+    if (!inb(sx, sy) || !inb(gx, gy) || !coarseGrid.test(sx, sy) || !coarseGrid.test(gx, gy))
+        return {};
+
+    ws.begin(size_t(cols) * rows);
+    open.clear();
+
+    // Min-heap on f; among equal f prefer deeper nodes so ties run toward the goal
+    auto worse = [](const Node& a, const Node& b) {
+        return a.f != b.f ? a.f > b.f : a.g < b.g;
+    };
+
+    int startIdx = sy * cols + sx;
+    int goalIdx = gy * cols + gx;
+    ws.reach(startIdx, 0, startIdx);
+    open.push_back({gridHeuristic(start, goal, conn), 0, startIdx});
+
+    const int DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    const int DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+    int dirs = conn == Connectivity::Four ? 4 : 8;
+    bool found = false;
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), worse);
+        Node cur = open.back();
+        open.pop_back();
+        // Lazy deletion: skip entries superseded by a cheaper push
+        if (ws.closed(cur.idx) || cur.g != ws.cost[cur.idx]) continue;
+        ws.close(cur.idx);
+        ++expanded;
+        if (cur.idx == goalIdx) { found = true; break; }
+
+        int x = cur.idx % cols, y = cur.idx / cols;
+        for (int d = 0; d < dirs; ++d) {
+            int nx = x + DX[d], ny = y + DY[d];
+            // Padding cells read as blocked, so no bounds check is needed here
+            if (!coarseGrid.test(nx, ny)) continue;
+            // No corner cutting: a diagonal step needs both side cells free
+            if (d >= 4 && (!coarseGrid.test(nx, y) || !coarseGrid.test(x, ny))) continue;
+
+            int ni = ny * cols + nx;
+            int ng = cur.g + (d < 4 ? STRAIGHT_COST : DIAGONAL_COST);
+            if (ws.closed(ni) || (ws.reached(ni) && ws.cost[ni] <= ng)) continue;
+            ws.reach(ni, ng, cur.idx);
+            open.push_back({ng + gridHeuristic({nx, ny}, goal, conn), ng, ni});
+            std::push_heap(open.begin(), open.end(), worse);
+        }
+    }
+
+    if (!found) return {};
+
+    std::vector<Tile> path;
+    for (int i = goalIdx; i != startIdx; i = ws.parent[i])
+        path.emplace_back(i % cols, i / cols);
+    path.emplace_back(sx, sy);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+#include "world/OccupancyGrid.h"
+#include "world/Pathfinding.h"
+#include "world/SearchWorkspace.h"
+
+enum class Connectivity { Four, Eight };
+
+// Step costs in tenths of a tile so diagonals stay integral
+constexpr int STRAIGHT_COST = 10;
+constexpr int DIAGONAL_COST = 14;
+
+// Manhattan distance for 4-connected grids, octile for 8-connected
+int gridHeuristic(Tile a, Tile b, Connectivity conn);
+
+// A* over the coarse grid. The search workspace and open list persist
+// between queries, so replanning allocates nothing once warmed up.
+class AStar {
+public:
+    explicit AStar(Connectivity conn = Connectivity::Four);
+
+    std::vector<Tile> findPath(Tile start, Tile goal, const OccupancyGrid& coarseGrid);
+
+    // Nodes expanded by the last query
+    size_t lastExpanded() const;
+
+private:
+    struct Node {
+        int f, g, idx;
+    };
+
+    Connectivity conn;
+    SearchWorkspace ws;
+    std::vector<Node> open;
+    size_t expanded = 0;
+};
@@ -0,0 +1,388 @@
+#include "world/BakedMap.h"
+#include "core/Constants.h"
+#include "world/PatrolCircuit.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char FILE_MAGIC[8] = {'G', 'H', 'B', 'A', 'K', 'E', 'D', '\0'};
+
+// Vertices and rects are stored as their in-memory bytes and drawn from the mapping
+static_assert(std::is_trivially_copyable<sf::Vertex>::value, "sf::Vertex is stored raw");
+static_assert(sizeof(sf::FloatRect) == 4 * sizeof(float), "sf::FloatRect is stored raw");
+
+enum SectionId : uint32_t {
+    VERTICES = 1,   // sf::Vertex[count]
+    COLLISION,      // sf::FloatRect[count]
+    TASK_INDEX,     // TaskEntry[count], ranges into TASK_RECTS
+    TASK_RECTS,     // sf::FloatRect[count]
+    WALKABLE,       // GridHeader, then the grid words
+    COARSE,         // GridHeader, then the grid words
+    PATROL,         // int32 x, y per tile
+};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t tileW, tileH;
+    uint32_t sectionCount;
+    uint64_t settings;  // settingsHash() at bake time
+};
+
+struct BakedMap::Section {
+    uint32_t id;
+    uint32_t count;     // elements; unused by the grid sections
+    uint64_t offset;    // from the start of the file, 8-byte aligned
+    uint64_t bytes;
+};
+
+struct BakedMap::TaskEntry {
+    char type[24];      // NUL-terminated
+    uint32_t first, count;
+};
+
+struct GridHeader {
+    int32_t cols, rows;
+    int32_t footprint;  // coarse only
+    int32_t pad;
+};
+
+// Words an OccupancyGrid of this size holds, padding included
+static size_t gridWords(int cols, int rows) {
+    return size_t((cols + 2 * OccupancyGrid::PAD_BITS + 63) / 64) * size_t(rows + 2);
+}
+
+static size_t align8(size_t n) {
+    return (n + 7) & ~size_t(7);
+}
+
+// FNV-1a over the constants and patrol circuit the grids and patrol tiles
+// are derived from, so a bake made before any of them changed is rejected
+static uint64_t settingsHash() {
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](const void* p, size_t n) {
+        const unsigned char* b = static_cast<const unsigned char*>(p);
+        for (size_t i = 0; i < n; ++i) {
+            h ^= b[i];
+            h *= 1099511628211ull;
+        }
+    };
+    int32_t ints[3] = {WORLD_W, WORLD_H, TILE_SIZE};
+    mix(ints, sizeof(ints));
+    mix(&ENEMY_SIZE, sizeof(ENEMY_SIZE));
+    for (const Vec2f& p : getRawPatrolCircuit()) {
+        mix(&p.x, sizeof(p.x));
+        mix(&p.y, sizeof(p.y));
+    }
+    return h;
+}
+
+BakedMap::~BakedMap() {
+    close();
+}
+
+const BakedMap::Section* BakedMap::find(uint32_t id) const {
+    for (uint32_t i = 0; i < sectionCount; ++i)
+        if (sections[i].id == id) return &sections[i];
+    return nullptr;
+}
+
+template <class T>
+BakedMap::View<T> BakedMap::view(uint32_t id, size_t skipBytes) const {
+    const Section* s = find(id);
+    if (!s) return {};
+    return {reinterpret_cast<const T*>(base + s->offset + skipBytes), (s->bytes - skipBytes) / sizeof(T)};
+}
+
+// --- Writing ---
+
+namespace {
+struct PendingSection {
+    uint32_t id;
+    uint32_t count;
+    std::string bytes;
+
+    void append(const void* p, size_t n) {
+        bytes.append(static_cast<const char*>(p), n);
+    }
+};
+
+PendingSection gridSection(uint32_t id, const OccupancyGrid& g, int footprint) {
+    PendingSection s{id, 0, {}};
+    GridHeader h{g.getCols(), g.getRows(), footprint, 0};
+    s.append(&h, sizeof(h));
+    s.append(g.data(), g.wordCount() * sizeof(uint64_t));
+    return s;
+}
+}
+
+bool BakedMap::write(const std::string& path, int tileW, int tileH,
+                     const std::vector<sf::Vertex>& vertices,
+                     const std::vector<sf::FloatRect>& collisionRects,
+                     const std::unordered_map<std::string, std::vector<sf::FloatRect>>& taskRects,
+                     const OccupancyGrid& walkable,
+                     const CoarseGrid& coarse,
+                     const std::vector<Tile>& patrolTiles)
+{
+    std::vector<PendingSection> pending;
+
+    PendingSection verts{VERTICES, uint32_t(vertices.size()), {}};
+    verts.append(vertices.data(), vertices.size() * sizeof(sf::Vertex));
+    pending.push_back(std::move(verts));
+
+    PendingSection coll{COLLISION, uint32_t(collisionRects.size()), {}};
+    coll.append(collisionRects.data(), collisionRects.size() * sizeof(sf::FloatRect));
+    pending.push_back(std::move(coll));
+
+    PendingSection index{TASK_INDEX, uint32_t(taskRects.size()), {}};
+    PendingSection rects{TASK_RECTS, 0, {}};
+    // Sorted so the same map always bakes to the same bytes
+    std::vector<std::string> types;
+    for (auto& kv : taskRects) types.push_back(kv.first);
+    std::sort(types.begin(), types.end());
+    for (auto& type : types) {
+        const std::vector<sf::FloatRect>& list = taskRects.at(type);
+        TaskEntry e{};
+        if (type.size() >= sizeof(e.type)) {
+            std::cerr << "Task type name too long to bake: " << type << "\n";
+            return false;
+        }
+        std::memcpy(e.type, type.data(), type.size());
+        e.first = rects.count;
+        e.count = uint32_t(list.size());
+        index.append(&e, sizeof(e));
+        rects.append(list.data(), list.size() * sizeof(sf::FloatRect));
+        rects.count += e.count;
+    }
+    pending.push_back(std::move(index));
+    pending.push_back(std::move(rects));
+
+    pending.push_back(gridSection(WALKABLE, walkable, 0));
+    pending.push_back(gridSection(COARSE, coarse.cells, coarse.footprint));
+
+    PendingSection patrol{PATROL, uint32_t(patrolTiles.size()), {}};
+    for (auto& t : patrolTiles) {
+        int32_t xy[2] = {t.first, t.second};
+        patrol.append(xy, sizeof(xy));
+    }
+    pending.push_back(std::move(patrol));
+
+    FileHeader header{};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.tileW = uint32_t(tileW);
+    header.tileH = uint32_t(tileH);
+    header.sectionCount = uint32_t(pending.size());
+    header.settings = settingsHash();
+
+    std::vector<Section> table;
+    size_t offset = align8(sizeof(FileHeader) + pending.size() * sizeof(Section));
+    for (auto& p : pending) {
+        table.push_back({p.id, p.count, offset, p.bytes.size()});
+        offset = align8(offset + p.bytes.size());
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to write baked map: " << path << "\n";
+        return false;
+    }
+    static const char ZEROS[8] = {};
+    size_t written = sizeof(FileHeader) + table.size() * sizeof(Section);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(Section));
+    for (size_t i = 0; i < pending.size(); ++i) {
+        out.write(ZEROS, table[i].offset - written);
+        out.write(pending[i].bytes.data(), pending[i].bytes.size());
+        written = table[i].offset + pending[i].bytes.size();
+    }
+    return bool(out);
+}
+
+// --- Mapping ---
+
+bool BakedMap::mapFile(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length) || length.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* mapped = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!mapped) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    size = size_t(length.QuadPart);
+    base = static_cast<const unsigned char*>(mapped);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    // The mapping keeps the file alive after the descriptor is closed
+    void* mapped = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+    size = size_t(st.st_size);
+    base = static_cast<const unsigned char*>(mapped);
+#endif
+    return true;
+}
+
+void BakedMap::close() {
+    if (!base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    fileHandle = mappingHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(base), size);
+#endif
+    base = nullptr;
+    size = 0;
+    sections = nullptr;
+    sectionCount = 0;
+}
+
+bool BakedMap::open(const std::string& path, int tileW, int tileH, const std::string& sourcePath) {
+    close();
+
+    // A map edited since the bake wins; a missing source means only the bake shipped
+    if (!sourcePath.empty()) {
+        std::error_code ec1, ec2;
+        auto bakedTime = std::filesystem::last_write_time(path, ec1);
+        auto sourceTime = std::filesystem::last_write_time(sourcePath, ec2);
+        if (!ec1 && !ec2 && sourceTime > bakedTime) {
+            std::cerr << "Baked map is older than " << sourcePath << ", ignoring it\n";
+            return false;
+        }
+    }
+
+    if (!mapFile(path)) return false;
+
+    FileHeader header;
+    bool ok = size >= sizeof(header);
+    if (ok) {
+        std::memcpy(&header, base, sizeof(header));
+        ok = std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 &&
+             header.version == VERSION &&
+             header.tileW == uint32_t(tileW) && header.tileH == uint32_t(tileH) &&
+             header.settings == settingsHash() &&
+             sizeof(FileHeader) + size_t(header.sectionCount) * sizeof(Section) <= size;
+    }
+    if (ok) {
+        sections = reinterpret_cast<const Section*>(base + sizeof(FileHeader));
+        sectionCount = header.sectionCount;
+        for (uint32_t i = 0; ok && i < sectionCount; ++i) {
+            const Section& s = sections[i];
+            ok = s.offset % 8 == 0 && s.offset <= size && s.bytes <= size - s.offset;
+        }
+    }
+
+    // Every section present and sized for what it claims to hold
+    auto sized = [&](uint32_t id, size_t elemBytes) {
+        const Section* s = find(id);
+        return s && s->bytes == size_t(s->count) * elemBytes;
+    };
+    auto grid = [&](uint32_t id) {
+        const Section* s = find(id);
+        if (!s || s->bytes < sizeof(GridHeader)) return false;
+        GridHeader h;
+        std::memcpy(&h, base + s->offset, sizeof(h));
+        return h.cols >= 0 && h.rows >= 0 &&
+               s->bytes == sizeof(GridHeader) + gridWords(h.cols, h.rows) * sizeof(uint64_t);
+    };
+    ok = ok && sized(VERTICES, sizeof(sf::Vertex)) && sized(COLLISION, sizeof(sf::FloatRect)) &&
+         sized(TASK_INDEX, sizeof(TaskEntry)) && sized(TASK_RECTS, sizeof(sf::FloatRect)) &&
+         sized(PATROL, 2 * sizeof(int32_t)) && grid(WALKABLE) && grid(COARSE);
+    if (ok) {
+        uint32_t rectCount = find(TASK_RECTS)->count;
+        for (const TaskEntry& e : view<TaskEntry>(TASK_INDEX))
+            ok = ok && e.type[sizeof(e.type) - 1] == '\0' && e.first <= rectCount && e.count <= rectCount - e.first;
+    }
+
+    if (!ok) {
+        std::cerr << "Baked map is invalid or out of date: " << path << "\n";
+        close();
+    }
+    return ok;
+}
+
+// --- Access ---
+
+BakedMap::View<sf::Vertex> BakedMap::vertices() const {
+    return view<sf::Vertex>(VERTICES);
+}
+
+BakedMap::View<sf::FloatRect> BakedMap::collisionRects() const {
+    return view<sf::FloatRect>(COLLISION);
+}
+
+BakedMap::View<sf::FloatRect> BakedMap::taskRects(const std::string& type) const {
+    View<sf::FloatRect> all = view<sf::FloatRect>(TASK_RECTS);
+    for (const TaskEntry& e : view<TaskEntry>(TASK_INDEX))
+        if (type == e.type) return {all.ptr + e.first, e.count};
+    return {};
+}
+
+std::vector<std::string> BakedMap::taskTypes() const {
+    std::vector<std::string> types;
+    for (const TaskEntry& e : view<TaskEntry>(TASK_INDEX))
+        types.emplace_back(e.type);
+    return types;
+}
+
+OccupancyGrid BakedMap::walkable() const {
+    const Section* s = find(WALKABLE);
+    GridHeader h;
+    std::memcpy(&h, base + s->offset, sizeof(h));
+    return OccupancyGrid(h.cols, h.rows, view<uint64_t>(WALKABLE, sizeof(GridHeader)).ptr);
+}
+
+CoarseGrid BakedMap::coarse(const OccupancyGrid& walkable) const {
+    const Section* s = find(COARSE);
+    GridHeader h;
+    std::memcpy(&h, base + s->offset, sizeof(h));
+    CoarseGrid cg;
+    cg.footprint = h.footprint;
+    cg.cells = OccupancyGrid(h.cols, h.rows, view<uint64_t>(COARSE, sizeof(GridHeader)).ptr);
+    cg.cols = h.cols;
+    cg.rows = h.rows;
+    cg.integral = std::make_shared<const IntegralImage>(walkable);
+    return cg;
+}
+
+std::vector<Tile> BakedMap::patrolTiles() const {
+    View<int32_t> xy = view<int32_t>(PATROL);
+    std::vector<Tile> tiles;
+    tiles.reserve(xy.size() / 2);
+    for (size_t i = 0; i + 1 < xy.size(); i += 2)
+        tiles.emplace_back(xy.ptr[i], xy.ptr[i + 1]);
+    return tiles;
+}
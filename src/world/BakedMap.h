@@ -0,0 +1,84 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "world/CoarseGrid.h"
+#include "world/OccupancyGrid.h"
+#include "world/Pathfinding.h"
+
+// Everything startup derives from the Tiled JSON, baked offline by
+// GradeHeistBake into one file and memory-mapped on later launches: tile
+// quads, collision rects, task rects by type, the walkable and coarse
+// grids and the patrol tiles.
+//
+// Layout: a header, a section table, then the sections, each 8-byte
+// aligned and in native byte order. open() rejects files of another
+// version or tile size, truncated files, files older than their map, and
+// files baked with other world or guard sizes or another patrol circuit.
+class BakedMap {
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    // Read-only run of elements inside the mapping
+    template <class T>
+    struct View {
+        const T* ptr = nullptr;
+        size_t count = 0;
+
+        const T* begin() const { return ptr; }
+        const T* end() const { return ptr + count; }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+    };
+
+    BakedMap() = default;
+    ~BakedMap();
+    BakedMap(const BakedMap&) = delete;
+    BakedMap& operator=(const BakedMap&) = delete;
+
+    static bool write(const std::string& path, int tileW, int tileH,
+                      const std::vector<sf::Vertex>& vertices,
+                      const std::vector<sf::FloatRect>& collisionRects,
+                      const std::unordered_map<std::string, std::vector<sf::FloatRect>>& taskRects,
+                      const OccupancyGrid& walkable,
+                      const CoarseGrid& coarse,
+                      const std::vector<Tile>& patrolTiles);
+
+    // sourcePath: the map the file was baked from; empty skips the age check
+    bool open(const std::string& path, int tileW, int tileH, const std::string& sourcePath = "");
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    // Point straight into the mapping; valid until close()
+    View<sf::Vertex> vertices() const;          // quads, four per tile
+    View<sf::FloatRect> collisionRects() const;
+    View<sf::FloatRect> taskRects(const std::string& type) const;
+    std::vector<std::string> taskTypes() const;
+
+    // The grids own their words, so these copy them out in one block each
+    OccupancyGrid walkable() const;
+    // walkable: the grid walkable() returned, reused for the integral image
+    CoarseGrid coarse(const OccupancyGrid& walkable) const;
+    std::vector<Tile> patrolTiles() const;
+
+private:
+    struct Section;
+    struct TaskEntry;
+
+    const unsigned char* base = nullptr;
+    size_t size = 0;
+    const Section* sections = nullptr;
+    uint32_t sectionCount = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+    bool mapFile(const std::string& path);
+    const Section* find(uint32_t id) const;
+    template <class T>
+    View<T> view(uint32_t id, size_t skipBytes = 0) const;
+};
@@ -1,29 +1,52 @@
 #include "world/CoarseGrid.h"
 #include <algorithm>
 
-std::vector<bool> buildCoarseGrid(const std::vector<bool>& grid, int worldW, int worldH, int tileSize, int enemySize) {
-    int pp = enemySize / tileSize;
-    int cols = worldW / tileSize;
-    int rows = worldH / tileSize;
-    int colsCoarse = cols - (pp - 1);
-    int rowsCoarse = rows - (pp - 1);
-
-    std::vector<bool> coarseGrid(colsCoarse * rowsCoarse, true);
-    for (int cy = 0; cy < rowsCoarse; ++cy) {
-        for (int cx = 0; cx < colsCoarse; ++cx) {
-            bool free = true;
-            for (int dy = 0; dy < pp && free; ++dy) {
-                for (int dx = 0; dx < pp; ++dx) {
-                    int ry = cy + dy;
-                    int rx = cx + dx;
-                    if (grid[ry * cols + rx]) {
-                        free = false;
-                        break;
-                    }
-                }
-            }
-            coarseGrid[cy * colsCoarse + cx] = free;
+IntegralImage::IntegralImage(const OccupancyGrid& grid)
+    : cols(grid.getCols()), rows(grid.getRows()), sums((cols + 1) * (rows + 1), 0)
+{
+    int stride = cols + 1;
+    for (int y = 0; y < rows; ++y) {
+        int rowSum = 0;
+        for (int x = 0; x < cols; ++x) {
+            rowSum += grid.test(x, y) ? 1 : 0;
+            sums[(y + 1) * stride + x + 1] = sums[y * stride + x + 1] + rowSum;
         }
     }
-    return coarseGrid;
+}
+
+int IntegralImage::blockedCount(int x, int y, int w, int h) const {
+    int stride = cols + 1;
+    return sums[(y + h) * stride + x + w] - sums[y * stride + x + w]
+         - sums[(y + h) * stride + x]     + sums[y * stride + x];
+}
+
+int IntegralImage::getCols() const { return cols; }
+int IntegralImage::getRows() const { return rows; }
+
+bool CoarseGrid::isFree(int x, int y, int size) const {
+    if (x < 0 || y < 0 || x + size > integral->getCols() || y + size > integral->getRows())
+        return false;
+    return integral->blockedCount(x, y, size, size) == 0;
+}
+
+CoarseGrid buildCoarseGrid(const OccupancyGrid& grid, int tileSize, int enemySize) {
+    return buildCoarseGrids(grid, tileSize, {enemySize}).front();
+}
+
+std::vector<CoarseGrid> buildCoarseGrids(const OccupancyGrid& grid, int tileSize, const std::vector<int>& enemySizes) {
+    auto integral = std::make_shared<const IntegralImage>(grid);
+    OccupancyGrid freeCells = grid.inverted();
+
+    std::vector<CoarseGrid> grids;
+    grids.reserve(enemySizes.size());
+    for (int size : enemySizes) {
+        CoarseGrid cg;
+        cg.footprint = std::max(1, size / tileSize);
+        cg.cells = freeCells.eroded(cg.footprint);
+        cg.cols = cg.cells.getCols();
+        cg.rows = cg.cells.getRows();
+        cg.integral = integral;
+        grids.push_back(std::move(cg));
+    }
+    return grids;
 }
@@ -1,5 +1,39 @@
 #pragma once
+#include <memory>
 #include <vector>
+#include "world/OccupancyGrid.h"
+
+// 2D prefix sum (integral image) of the blocked fine grid.
+// Counts the blocked cells inside any box in O(1).
+class IntegralImage {
+public:
+    explicit IntegralImage(const OccupancyGrid& grid);
+
+    // Number of blocked fine cells in the w*h box whose top-left cell is (x,y)
+    int blockedCount(int x, int y, int w, int h) const;
+
+    int getCols() const;
+    int getRows() const;
+
+private:
+    int cols, rows;
+    std::vector<int> sums;   // (cols+1)*(rows+1), sums[y*(cols+1)+x] = blocked cells above-left of (x,y)
+};
+
+// Where an agent of a given footprint fits, anchored at the footprint's top-left fine cell
+struct CoarseGrid {
+    int footprint = 0;          // agent size in fine tiles
+    int cols = 0, rows = 0;     // coarse dimensions
+    OccupancyGrid cells;        // set = footprint anchored here is free
+    std::shared_ptr<const IntegralImage> integral;
+
+    // O(1) check for an arbitrary size footprint at fine cell (x,y)
+    bool isFree(int x, int y, int size) const;
+};
 
 // Build coarse grid for enemy pathfinding
-std::vector<bool> buildCoarseGrid(const std::vector<bool>& grid, int worldW, int worldH, int tileSize, int enemySize);
+CoarseGrid buildCoarseGrid(const OccupancyGrid& grid, int tileSize, int enemySize);
+
+// Build one coarse grid per agent size, all sharing a single integral image.
+// Each footprint is an erosion of the free cells by shifted ANDs of whole rows.
+std::vector<CoarseGrid> buildCoarseGrids(const OccupancyGrid& grid, int tileSize, const std::vector<int>& enemySizes);
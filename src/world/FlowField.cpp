@@ -0,0 +1,59 @@
+#include "world/FlowField.h"
+#include <algorithm>
+
+static const int DX[4] = {1, -1, 0, 0};
+static const int DY[4] = {0, 0, 1, -1};
+
+FlowField::FlowField(const OccupancyGrid& G)
+    : grid(G), dist(size_t(G.getCols()) * G.getRows(), -1)
+{
+}
+
+Tile FlowField::getTarget() const {
+    return target;
+}
+
+bool FlowField::setTarget(Tile t) {
+    if (t == target) return false;
+    target = t;
+
+    int cols = grid.getCols(), rows = grid.getRows();
+    std::fill(dist.begin(), dist.end(), -1);
+    queue.clear();
+    if (t.first < 0 || t.first >= cols || t.second < 0 || t.second >= rows || !grid.test(t.first, t.second))
+        return true;
+
+    int s = t.second * cols + t.first;
+    dist[s] = 0;
+    queue.push_back(s);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int cur = queue[head];
+        int x = cur % cols, y = cur / cols;
+        for (int d = 0; d < 4; ++d) {
+            int nx = x + DX[d], ny = y + DY[d];
+            // Padding cells read as blocked, so no bounds check is needed here
+            if (!grid.test(nx, ny)) continue;
+            int ni = ny * cols + nx;
+            if (dist[ni] >= 0) continue;
+            dist[ni] = dist[cur] + 1;
+            queue.push_back(ni);
+        }
+    }
+    return true;
+}
+
+int FlowField::distance(Tile t) const {
+    int cols = grid.getCols(), rows = grid.getRows();
+    if (t.first < 0 || t.first >= cols || t.second < 0 || t.second >= rows) return -1;
+    return dist[t.second * cols + t.first];
+}
+
+Tile FlowField::nextStep(Tile from) const {
+    int here = distance(from);
+    if (here <= 0) return from;
+    for (int d = 0; d < 4; ++d) {
+        Tile n(from.first + DX[d], from.second + DY[d]);
+        if (distance(n) == here - 1) return n;
+    }
+    return from;
+}
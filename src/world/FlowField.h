@@ -0,0 +1,29 @@
+#pragma once
+#include <vector>
+#include "world/OccupancyGrid.h"
+#include "world/Pathfinding.h"
+
+// Distance field over the coarse grid, grown by BFS from one target tile.
+// It is shared by every chasing guard: each one just steps downhill, so a
+// player move costs one O(cells) rebuild however many guards follow it.
+class FlowField {
+public:
+    explicit FlowField(const OccupancyGrid& coarseGrid);
+
+    // Rebuilds only when the target tile changed; returns true if it did
+    bool setTarget(Tile target);
+    Tile getTarget() const;
+
+    // Steps from t to the target, or -1 if t cannot reach it
+    int distance(Tile t) const;
+
+    // Neighbour of `from` one step closer to the target. Returns `from`
+    // itself when it is the target or cut off from it.
+    Tile nextStep(Tile from) const;
+
+private:
+    const OccupancyGrid& grid;
+    std::vector<int> dist;
+    std::vector<int> queue;
+    Tile target{-1, -1};
+};
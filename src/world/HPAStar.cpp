@@ -0,0 +1,277 @@
+#include "world/HPAStar.h"
+#include "world/AStar.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <queue>
+
+// Entrances shorter than this get one transition in the middle, longer
+// ones a transition at each end
+static const int LONG_ENTRANCE = 6;
+
+HPAStar::HPAStar(const OccupancyGrid& G, int size)
+    : grid(G), clusterSize(std::max(2, size))
+{
+    clustersX = (grid.getCols() + clusterSize - 1) / clusterSize;
+    clustersY = (grid.getRows() + clusterSize - 1) / clusterSize;
+    nodeAt.assign(size_t(grid.getCols()) * grid.getRows(), -1);
+    clusterNodes.resize(size_t(clustersX) * clustersY);
+    localDist.resize(size_t(clusterSize) * clusterSize);
+    localParent.resize(localDist.size());
+
+    buildEntrances();
+    for (int c = 0; c < int(clusterNodes.size()); ++c)
+        buildIntraEdges(c);
+}
+
+size_t HPAStar::nodeCount() const {
+    return nodes.size();
+}
+
+size_t HPAStar::edgeCount() const {
+    size_t n = 0;
+    for (auto& node : nodes) n += node.edges.size();
+    return n;
+}
+
+int HPAStar::clusterOf(Tile t) const {
+    return (t.second / clusterSize) * clustersX + t.first / clusterSize;
+}
+
+int HPAStar::addNode(Tile t) {
+    int& id = nodeAt[size_t(t.second) * grid.getCols() + t.first];
+    if (id < 0) {
+        id = int(nodes.size());
+        nodes.push_back({t, clusterOf(t), {}});
+        clusterNodes[nodes.back().cluster].push_back(id);
+    }
+    return id;
+}
+
+void HPAStar::addEdge(int a, int b, int c) {
+    nodes[a].edges.push_back({b, c});
+}
+
+// Scan every cluster border for runs of cells free on both sides
+void HPAStar::buildEntrances() {
+    int cols = grid.getCols(), rows = grid.getRows();
+
+    // Emit transitions for the run [from, to) along a border; `cell` maps a
+    // position along the run to the pair of facing cells
+    auto emitRun = [&](int from, int to, auto cell) {
+        if (to <= from) return;
+        std::vector<int> picks;
+        if (to - from < LONG_ENTRANCE) picks = {(from + to - 1) / 2};
+        else picks = {from, to - 1};
+        for (int p : picks) {
+            auto [a, b] = cell(p);
+            int na = addNode(a), nb = addNode(b);
+            addEdge(na, nb, STRAIGHT_COST);
+            addEdge(nb, na, STRAIGHT_COST);
+        }
+    };
+
+    // Vertical borders between horizontally adjacent clusters
+    for (int x = clusterSize - 1; x + 1 < cols; x += clusterSize) {
+        for (int y0 = 0; y0 < rows; y0 += clusterSize) {
+            int y1 = std::min(y0 + clusterSize, rows);
+            auto cell = [&](int y) { return std::make_pair(Tile(x, y), Tile(x + 1, y)); };
+            int run = y0;
+            for (int y = y0; y < y1; ++y) {
+                if (!grid.test(x, y) || !grid.test(x + 1, y)) {
+                    emitRun(run, y, cell);
+                    run = y + 1;
+                }
+            }
+            emitRun(run, y1, cell);
+        }
+    }
+
+    // Horizontal borders between vertically adjacent clusters
+    for (int y = clusterSize - 1; y + 1 < rows; y += clusterSize) {
+        for (int x0 = 0; x0 < cols; x0 += clusterSize) {
+            int x1 = std::min(x0 + clusterSize, cols);
+            auto cell = [&](int x) { return std::make_pair(Tile(x, y), Tile(x, y + 1)); };
+            int run = x0;
+            for (int x = x0; x < x1; ++x) {
+                if (!grid.test(x, y) || !grid.test(x, y + 1)) {
+                    emitRun(run, x, cell);
+                    run = x + 1;
+                }
+            }
+            emitRun(run, x1, cell);
+        }
+    }
+}
+
+void HPAStar::buildIntraEdges(int c) {
+    const std::vector<int>& ids = clusterNodes[c];
+    int x0 = (c % clustersX) * clusterSize;
+    int y0 = (c / clustersX) * clusterSize;
+    for (int a : ids) {
+        searchCluster(c, nodes[a].tile);
+        for (int b : ids) {
+            if (b == a) continue;
+            Tile t = nodes[b].tile;
+            int d = localDist[(t.second - y0) * clusterSize + (t.first - x0)];
+            if (d >= 0) addEdge(a, b, d * STRAIGHT_COST);
+        }
+    }
+}
+
+// BFS from src without leaving its cluster; fills localDist/localParent
+void HPAStar::searchCluster(int c, Tile src) {
+    int x0 = (c % clustersX) * clusterSize;
+    int y0 = (c / clustersX) * clusterSize;
+    int x1 = std::min(x0 + clusterSize, grid.getCols());
+    int y1 = std::min(y0 + clusterSize, grid.getRows());
+
+    std::fill(localDist.begin(), localDist.end(), -1);
+    queue.clear();
+    int s = (src.second - y0) * clusterSize + (src.first - x0);
+    localDist[s] = 0;
+    localParent[s] = s;
+    queue.push_back(s);
+
+    const int DX[4] = {1, -1, 0, 0};
+    const int DY[4] = {0, 0, 1, -1};
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int cur = queue[head];
+        int x = x0 + cur % clusterSize, y = y0 + cur / clusterSize;
+        for (int d = 0; d < 4; ++d) {
+            int nx = x + DX[d], ny = y + DY[d];
+            if (nx < x0 || nx >= x1 || ny < y0 || ny >= y1 || !grid.test(nx, ny)) continue;
+            int ni = (ny - y0) * clusterSize + (nx - x0);
+            if (localDist[ni] >= 0) continue;
+            localDist[ni] = localDist[cur] + 1;
+            localParent[ni] = cur;
+            queue.push_back(ni);
+        }
+    }
+}
+
+// Shortest in-cluster path between two cells of the same cluster
+std::vector<Tile> HPAStar::clusterPath(Tile a, Tile b) {
+    int c = clusterOf(a);
+    int x0 = (c % clustersX) * clusterSize;
+    int y0 = (c / clustersX) * clusterSize;
+    searchCluster(c, a);
+
+    int i = (b.second - y0) * clusterSize + (b.first - x0);
+    if (localDist[i] < 0) return {};
+    std::vector<Tile> path;
+    for (;;) {
+        path.emplace_back(x0 + i % clusterSize, y0 + i / clusterSize);
+        if (localParent[i] == i) break;
+        i = localParent[i];
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<Tile> HPAStar::findAbstractPath(Tile start, Tile goal) {
+    int cols = grid.getCols(), rows = grid.getRows();
+    auto inb = [&](Tile t) { return t.first >= 0 && t.first < cols && t.second >= 0 && t.second < rows; };
+    if (!inb(start) || !inb(goal) || !grid.test(start.first, start.second) || !grid.test(goal.first, goal.second))
+        return {};
+    if (start == goal) return {start};
+
+    // Start and goal join the graph only for this query, as the last two ids
+    const int n = int(nodes.size());
+    const int S = n, G = n + 1;
+    int cs = clusterOf(start), cg = clusterOf(goal);
+
+    auto localIndex = [&](int c, Tile t) {
+        return (t.second - (c / clustersX) * clusterSize) * clusterSize + (t.first - (c % clustersX) * clusterSize);
+    };
+
+    startCost.assign(n + 2, -1);
+    goalCost.assign(n + 2, -1);
+    searchCluster(cs, start);
+    for (int id : clusterNodes[cs]) {
+        int d = localDist[localIndex(cs, nodes[id].tile)];
+        if (d >= 0) startCost[id] = d * STRAIGHT_COST;
+    }
+    if (cs == cg) {
+        int d = localDist[localIndex(cs, goal)];
+        if (d >= 0) startCost[G] = d * STRAIGHT_COST;
+    }
+    searchCluster(cg, goal);
+    for (int id : clusterNodes[cg]) {
+        int d = localDist[localIndex(cg, nodes[id].tile)];
+        if (d >= 0) goalCost[id] = d * STRAIGHT_COST;
+    }
+
+    auto tileOf = [&](int id) { return id == S ? start : id == G ? goal : nodes[id].tile; };
+
+    cost.assign(n + 2, INT_MAX);
+    parent.assign(n + 2, -1);
+    closed.assign(n + 2, 0);
+
+    struct Item {
+        int f, g, id;
+    };
+    // Min-heap on f; ties go to deeper nodes like the flat A*
+    auto worse = [](const Item& a, const Item& b) { return a.f != b.f ? a.f > b.f : a.g < b.g; };
+    std::priority_queue<Item, std::vector<Item>, decltype(worse)> open(worse);
+
+    cost[S] = 0;
+    open.push({gridHeuristic(start, goal, Connectivity::Four), 0, S});
+    auto relax = [&](int from, int to, int c) {
+        int ng = cost[from] + c;
+        if (closed[to] || ng >= cost[to]) return;
+        cost[to] = ng;
+        parent[to] = from;
+        open.push({ng + gridHeuristic(tileOf(to), goal, Connectivity::Four), ng, to});
+    };
+
+    bool found = false;
+    while (!open.empty()) {
+        Item cur = open.top();
+        open.pop();
+        if (closed[cur.id] || cur.g != cost[cur.id]) continue;
+        closed[cur.id] = 1;
+        if (cur.id == G) { found = true; break; }
+
+        if (cur.id == S) {
+            for (int id : clusterNodes[cs])
+                if (startCost[id] >= 0) relax(S, id, startCost[id]);
+            if (startCost[G] >= 0) relax(S, G, startCost[G]);
+            continue;
+        }
+        for (const Edge& e : nodes[cur.id].edges) relax(cur.id, e.to, e.cost);
+        if (goalCost[cur.id] >= 0) relax(cur.id, G, goalCost[cur.id]);
+    }
+    if (!found) return {};
+
+    std::vector<Tile> route;
+    for (int id = G; id != -1; id = parent[id]) {
+        Tile t = tileOf(id);
+        // Start or goal sitting on an entrance shows up twice
+        if (route.empty() || route.back() != t) route.push_back(t);
+    }
+    std::reverse(route.begin(), route.end());
+    return route;
+}
+
+std::vector<Tile> HPAStar::refine(const std::vector<Tile>& route, size_t segments) {
+    if (route.empty()) return {};
+    std::vector<Tile> path{route[0]};
+    for (size_t i = 0; i + 1 < route.size() && i < segments; ++i) {
+        Tile a = route[i], b = route[i + 1];
+        if (clusterOf(a) != clusterOf(b)) {
+            // Inter-cluster edges are always a single step across the border
+            path.push_back(b);
+            continue;
+        }
+        auto leg = clusterPath(a, b);
+        if (leg.empty()) break;
+        path.insert(path.end(), leg.begin() + 1, leg.end());
+    }
+    return path;
+}
+
+std::vector<Tile> HPAStar::findPath(Tile start, Tile goal) {
+    auto route = findAbstractPath(start, goal);
+    return refine(route, route.size());
+}
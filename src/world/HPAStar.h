@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include "world/OccupancyGrid.h"
+#include "world/Pathfinding.h"
+
+// Hierarchical A* (HPA*) over the coarse grid, 4-connected. The grid is
+// cut into square clusters; free cells facing each other across a cluster
+// border form entrances, and every entrance cell becomes an abstract node.
+// Nodes in one cluster are linked by their precomputed in-cluster distance.
+// Queries search the small abstract graph and refine segments on demand,
+// so cost follows path length and cluster size rather than map area.
+// Paths are near-optimal: detours forced by cluster borders are kept.
+class HPAStar {
+public:
+    explicit HPAStar(const OccupancyGrid& coarseGrid, int clusterSize = 16);
+
+    // Start, the entrance cells crossed, then goal. Empty if unreachable.
+    std::vector<Tile> findAbstractPath(Tile start, Tile goal);
+
+    // Tiles along the first `segments` legs of an abstract route. Each leg
+    // stays inside one cluster or steps across one border.
+    std::vector<Tile> refine(const std::vector<Tile>& route, size_t segments);
+
+    // Abstract search followed by full refinement
+    std::vector<Tile> findPath(Tile start, Tile goal);
+
+    size_t nodeCount() const;
+    size_t edgeCount() const;
+
+private:
+    struct Edge {
+        int to, cost;
+    };
+    struct Node {
+        Tile tile;
+        int cluster;
+        std::vector<Edge> edges;
+    };
+
+    const OccupancyGrid& grid;
+    int clusterSize;
+    int clustersX, clustersY;
+
+    std::vector<Node> nodes;
+    std::vector<int> nodeAt;                    // cell -> node id or -1
+    std::vector<std::vector<int>> clusterNodes; // cluster -> node ids
+
+    // Scratch for in-cluster BFS
+    std::vector<int> localDist, localParent, queue;
+
+    // Scratch for the abstract search; the last two slots are start and goal
+    std::vector<int> cost, parent, startCost, goalCost;
+    std::vector<char> closed;
+
+    int clusterOf(Tile t) const;
+    int addNode(Tile t);
+    void addEdge(int a, int b, int cost);
+    void buildEntrances();
+    void buildIntraEdges(int cluster);
+    void searchCluster(int cluster, Tile src);
+    std::vector<Tile> clusterPath(Tile a, Tile b);
+};
@@ -0,0 +1,275 @@
+#include "world/IncrementalPlanner.h"
+#include <algorithm>
+#include <cstdlib>
+
+static const int INF = 1 << 29;
+
+IncrementalPlanner::IncrementalPlanner(Connectivity c)
+    : conn(c)
+{
+}
+
+size_t IncrementalPlanner::lastExpanded() const {
+    return expanded;
+}
+
+void IncrementalPlanner::reset() {
+    initialized = false;
+}
+
+int IncrementalPlanner::heuristic(int a, int b) const {
+    return gridHeuristic({a % cols, a / cols}, {b % cols, b / cols}, conn);
+}
+
+IncrementalPlanner::Key IncrementalPlanner::calcKey(int s) const {
+    int64_t m = std::min(g[s], rhs[s]);
+    return {m + heuristic(s, goalIdx) + km, m};
+}
+
+// Free neighbours of s and the cost of stepping to them. The grid is
+// undirected, so these are both the successors and the predecessors.
+int IncrementalPlanner::neighbours(int s, int* out, int* cost) const {
+    static const int DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    static const int DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+    int x = s % cols, y = s / cols;
+    int dirs = conn == Connectivity::Four ? 4 : 8;
+    int n = 0;
+    for (int d = 0; d < dirs; ++d) {
+        int nx = x + DX[d], ny = y + DY[d];
+        // Padding cells read as blocked, so no bounds check is needed here
+        if (!grid->test(nx, ny)) continue;
+        if (d >= 4 && (!grid->test(nx, y) || !grid->test(x, ny))) continue;
+        out[n] = ny * cols + nx;
+        cost[n] = d < 4 ? STRAIGHT_COST : DIAGONAL_COST;
+        ++n;
+    }
+    return n;
+}
+
+void IncrementalPlanner::recomputeRhs(int s) {
+    int nb[8], c[8];
+    rhs[s] = INF;
+    par[s] = -1;
+    if (!grid->test(s % cols, s / cols)) return;
+    int n = neighbours(s, nb, c);
+    for (int i = 0; i < n; ++i) {
+        if (g[nb[i]] >= INF) continue;
+        int v = g[nb[i]] + c[i];
+        if (v < rhs[s]) {
+            rhs[s] = v;
+            par[s] = nb[i];
+        }
+    }
+}
+
+// Toggling a cell adds or removes its own edges and, through the corner
+// rule, the diagonals passing by it, so the cell and its 8 neighbours get
+// their rhs recomputed. computePath spreads the change from there.
+void IncrementalPlanner::cellChanged(Tile t) {
+    if (!initialized) return;
+    for (int y = t.second - 1; y <= t.second + 1; ++y) {
+        for (int x = t.first - 1; x <= t.first + 1; ++x) {
+            if (x < 0 || x >= cols || y < 0 || y >= rows) continue;
+            int s = y * cols + x;
+            if (s == startIdx) continue;
+            recomputeRhs(s);
+            updateState(s);
+        }
+    }
+}
+
+void IncrementalPlanner::updateState(int s) {
+    bool queued = heapPos[s] >= 0;
+    if (g[s] != rhs[s]) {
+        if (queued) heapUpdate(s, calcKey(s));
+        else heapPush(s, calcKey(s));
+    } else if (queued) {
+        heapRemove(s);
+    }
+}
+
+void IncrementalPlanner::initialize(int s, int t) {
+    size_t cells = size_t(cols) * rows;
+    g.assign(cells, INF);
+    rhs.assign(cells, INF);
+    par.assign(cells, -1);
+    heapPos.assign(cells, -1);
+    heap.clear();
+    km = 0;
+    startIdx = s;
+    goalIdx = t;
+    rhs[s] = 0;
+    heapPush(s, calcKey(s));
+    initialized = true;
+}
+
+bool IncrementalPlanner::computePath() {
+    int nb[8], c[8];
+    while (!heap.empty() &&
+           (heap[0].key < calcKey(goalIdx) || rhs[goalIdx] > g[goalIdx])) {
+        int u = heap[0].idx;
+        Key kOld = heap[0].key;
+        Key kNew = calcKey(u);
+        if (kOld < kNew) {
+            // Key went stale when the target moved; requeue with the real key
+            heapUpdate(u, kNew);
+            continue;
+        }
+        ++expanded;
+        int n = neighbours(u, nb, c);
+        if (g[u] > rhs[u]) {
+            g[u] = rhs[u];
+            heapRemove(u);
+            for (int i = 0; i < n; ++i) {
+                int s = nb[i];
+                if (s != startIdx && rhs[s] > g[u] + c[i]) {
+                    par[s] = u;
+                    rhs[s] = g[u] + c[i];
+                    updateState(s);
+                }
+            }
+        } else {
+            g[u] = INF;
+            for (int i = 0; i < n; ++i) {
+                int s = nb[i];
+                if (s != startIdx && par[s] == u) {
+                    recomputeRhs(s);
+                    updateState(s);
+                }
+            }
+            updateState(u);
+        }
+    }
+    return rhs[goalIdx] < INF;
+}
+
+// The new root keeps its rhs, which offsets every distance in its subtree by
+// the same constant, so that subtree stays valid. Cells of the old tree
+// outside it are cleared in one pass and reseeded from their neighbours.
+void IncrementalPlanner::moveRoot(int s) {
+    int nb[8], c[8];
+    int oldStart = startIdx;
+    startIdx = s;
+    par[s] = -1;
+
+    deleted.clear();
+    deleted.push_back(oldStart);
+    for (size_t i = 0; i < deleted.size(); ++i) {
+        int u = deleted[i];
+        int n = neighbours(u, nb, c);
+        for (int k = 0; k < n; ++k)
+            if (par[nb[k]] == u) deleted.push_back(nb[k]);
+    }
+    for (int u : deleted) {
+        g[u] = rhs[u] = INF;
+        par[u] = -1;
+        if (heapPos[u] >= 0) heapRemove(u);
+    }
+    for (int u : deleted) {
+        recomputeRhs(u);
+        if (rhs[u] < INF) heapPush(u, calcKey(u));
+    }
+}
+
+std::vector<Tile> IncrementalPlanner::plan(Tile start, Tile goal, const OccupancyGrid& coarseGrid) {
+    expanded = 0;
+    auto inb = [&](Tile t) {
+        return t.first >= 0 && t.first < coarseGrid.getCols() && t.second >= 0 && t.second < coarseGrid.getRows();
+    };
+    if (!inb(start) || !inb(goal) || !coarseGrid.test(start.first, start.second) ||
+        !coarseGrid.test(goal.first, goal.second))
+        return {};
+
+    if (grid != &coarseGrid || cols != coarseGrid.getCols() || rows != coarseGrid.getRows()) {
+        grid = &coarseGrid;
+        cols = coarseGrid.getCols();
+        rows = coarseGrid.getRows();
+        initialized = false;
+    }
+
+    int s = start.second * cols + start.first;
+    int t = goal.second * cols + goal.first;
+
+    // A root the old tree never reached has no usable distance; start over
+    if (!initialized || (s != startIdx && rhs[s] >= INF)) {
+        initialize(s, t);
+    } else {
+        if (t != goalIdx) {
+            km += heuristic(goalIdx, t);
+            goalIdx = t;
+        }
+        if (s != startIdx) moveRoot(s);
+    }
+
+    if (!computePath()) return {};
+
+    std::vector<Tile> path;
+    size_t limit = size_t(cols) * rows;
+    for (int i = goalIdx; i != startIdx; i = par[i]) {
+        if (i < 0 || path.size() > limit) {
+            // Broken tree; should not happen, but never hand back a bad path
+            initialized = false;
+            return {};
+        }
+        path.emplace_back(i % cols, i / cols);
+    }
+    path.emplace_back(start);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void IncrementalPlanner::heapPush(int s, Key k) {
+    heapPos[s] = int(heap.size());
+    heap.push_back({k, s});
+    siftUp(heapPos[s]);
+}
+
+void IncrementalPlanner::heapUpdate(int s, Key k) {
+    int i = heapPos[s];
+    Key old = heap[i].key;
+    heap[i].key = k;
+    if (k < old) siftUp(i);
+    else siftDown(i);
+}
+
+void IncrementalPlanner::heapRemove(int s) {
+    int i = heapPos[s];
+    int last = int(heap.size()) - 1;
+    if (i != last) {
+        heapSwap(i, last);
+        heap.pop_back();
+        heapPos[s] = -1;
+        siftUp(i);
+        siftDown(i);
+    } else {
+        heap.pop_back();
+        heapPos[s] = -1;
+    }
+}
+
+void IncrementalPlanner::heapSwap(int a, int b) {
+    std::swap(heap[a], heap[b]);
+    heapPos[heap[a].idx] = a;
+    heapPos[heap[b].idx] = b;
+}
+
+void IncrementalPlanner::siftUp(int i) {
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (!(heap[i].key < heap[p].key)) break;
+        heapSwap(i, p);
+        i = p;
+    }
+}
+
+void IncrementalPlanner::siftDown(int i) {
+    int n = int(heap.size());
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if (l < n && heap[l].key < heap[m].key) m = l;
+        if (r < n && heap[r].key < heap[m].key) m = r;
+        if (m == i) break;
+        heapSwap(i, m);
+        i = m;
+    }
+}
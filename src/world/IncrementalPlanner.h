@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "world/AStar.h"
+#include "world/OccupancyGrid.h"
+#include "world/Pathfinding.h"
+
+// Moving Target D* Lite for chasing a moving player over a coarse grid.
+// The search runs forward from the hunter and its tree is kept between
+// calls:
+//  - when the target moves, queued keys are corrected lazily via km
+//  - when the hunter steps, the new tile becomes the root and only the
+//    part of the old tree outside its subtree is thrown away
+//  - when a cell is toggled, cellChanged() requeues the cells around it
+// Each call returns a shortest path from start to goal.
+class IncrementalPlanner {
+public:
+    explicit IncrementalPlanner(Connectivity conn = Connectivity::Four);
+
+    std::vector<Tile> plan(Tile start, Tile goal, const OccupancyGrid& coarseGrid);
+
+    // Drop the search tree; the next plan starts from scratch
+    void reset();
+
+    // The cell at t was blocked or freed in the grid last planned on.
+    // Repairs the tree around it so the next plan needs no reset.
+    void cellChanged(Tile t);
+
+    // Nodes expanded by the last call
+    size_t lastExpanded() const;
+
+private:
+    struct Key {
+        int64_t k1, k2;
+        bool operator<(const Key& o) const { return k1 != o.k1 ? k1 < o.k1 : k2 < o.k2; }
+    };
+    struct Entry {
+        Key key;
+        int idx;
+    };
+
+    Connectivity conn;
+    const OccupancyGrid* grid = nullptr;
+    int cols = 0, rows = 0;
+    bool initialized = false;
+
+    std::vector<int> g, rhs, par;
+    std::vector<int> heapPos;        // index into heap, -1 when not queued
+    std::vector<Entry> heap;
+    std::vector<int> deleted;        // scratch for moveRoot
+
+    int startIdx = -1, goalIdx = -1;
+    int64_t km = 0;
+    size_t expanded = 0;
+
+    void initialize(int s, int t);
+    Key calcKey(int s) const;
+    int heuristic(int a, int b) const;
+    int neighbours(int s, int* out, int* cost) const;
+    void recomputeRhs(int s);
+    void updateState(int s);
+    void moveRoot(int s);
+    bool computePath();
+
+    // Indexed binary heap
+    void heapPush(int s, Key k);
+    void heapUpdate(int s, Key k);
+    void heapRemove(int s);
+    void heapSwap(int a, int b);
+    void siftUp(int i);
+    void siftDown(int i);
+};
@@ -0,0 +1,257 @@
+#include "world/JumpPointSearch.h"
+#include <algorithm>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Index of the lowest / highest set bit of a non-zero word
+static int lowestBit(uint64_t w) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, w);
+    return int(i);
+#else
+    return __builtin_ctzll(w);
+#endif
+}
+
+static int highestBit(uint64_t w) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanReverse64(&i, w);
+    return int(i);
+#else
+    return 63 - __builtin_clzll(w);
+#endif
+}
+
+static int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+size_t JumpPointSearch::lastExpanded() const {
+    return expanded;
+}
+
+// Scan along row y from x (inclusive) in direction dx. Stops at the first
+// cell that is blocked, is the goal, or has a forced neighbour above or
+// below (open now, but closed one step back). Each iteration checks 64
+// cells at once; the zero padding words guarantee the scan terminates.
+bool JumpPointSearch::jumpHorizontal(int x, int y, int dx, int& jx) const {
+    const uint64_t* R = grid->row(y);
+    const uint64_t* U = grid->row(y - 1);
+    const uint64_t* D = grid->row(y + 1);
+    int stride = grid->getStride();
+    int b = x + OccupancyGrid::PAD_BITS;
+    int goalBit = goalY == y ? goalX + OccupancyGrid::PAD_BITS : -1;
+
+    if (dx > 0) {
+        uint64_t mask = ~uint64_t(0) << (b & 63);
+        for (int i = b >> 6; i < stride; ++i) {
+            // Bit p of *Prev holds cell p-1, the cell we came from
+            uint64_t uPrev = (U[i] << 1) | (i > 0 ? U[i - 1] >> 63 : 0);
+            uint64_t dPrev = (D[i] << 1) | (i > 0 ? D[i - 1] >> 63 : 0);
+            uint64_t stop = ~R[i] | (U[i] & ~uPrev) | (D[i] & ~dPrev);
+            if ((goalBit >> 6) == i) stop |= uint64_t(1) << (goalBit & 63);
+            stop &= mask;
+            mask = ~uint64_t(0);
+            if (stop) {
+                int p = i * 64 + lowestBit(stop) - OccupancyGrid::PAD_BITS;
+                if (!grid->test(p, y)) return false;
+                jx = p;
+                return true;
+            }
+        }
+    } else {
+        uint64_t mask = ~uint64_t(0) >> (63 - (b & 63));
+        for (int i = b >> 6; i >= 0; --i) {
+            // Bit p of *Next holds cell p+1, the cell we came from
+            uint64_t uNext = (U[i] >> 1) | (i + 1 < stride ? U[i + 1] << 63 : 0);
+            uint64_t dNext = (D[i] >> 1) | (i + 1 < stride ? D[i + 1] << 63 : 0);
+            uint64_t stop = ~R[i] | (U[i] & ~uNext) | (D[i] & ~dNext);
+            if (goalBit >= 0 && (goalBit >> 6) == i) stop |= uint64_t(1) << (goalBit & 63);
+            stop &= mask;
+            mask = ~uint64_t(0);
+            if (stop) {
+                int p = i * 64 + highestBit(stop) - OccupancyGrid::PAD_BITS;
+                if (!grid->test(p, y)) return false;
+                jx = p;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool JumpPointSearch::jumpVertical(int x, int y, int dy, int& jy) const {
+    const OccupancyGrid& g = *grid;
+    for (;; y += dy) {
+        if (!g.test(x, y)) return false;
+        if (x == goalX && y == goalY) { jy = y; return true; }
+        if ((g.test(x - 1, y) && !g.test(x - 1, y - dy)) ||
+            (g.test(x + 1, y) && !g.test(x + 1, y - dy))) {
+            jy = y;
+            return true;
+        }
+    }
+}
+
+bool JumpPointSearch::jump(int x, int y, int dx, int dy, int& jx, int& jy) const {
+    const OccupancyGrid& g = *grid;
+    if (dx != 0 && dy != 0) {
+        for (;;) {
+            if (!g.test(x, y)) return false;
+            if (x == goalX && y == goalY) { jx = x; jy = y; return true; }
+            // A diagonal step is a jump point if a straight jump from it finds one
+            int tmp;
+            if (jumpHorizontal(x + dx, y, dx, tmp) || jumpVertical(x, y + dy, dy, tmp)) {
+                jx = x;
+                jy = y;
+                return true;
+            }
+            if (!g.test(x + dx, y) || !g.test(x, y + dy)) return false;
+            x += dx;
+            y += dy;
+        }
+    }
+    if (dx != 0) {
+        if (!jumpHorizontal(x, y, dx, jx)) return false;
+        jy = y;
+        return true;
+    }
+    if (!jumpVertical(x, y, dy, jy)) return false;
+    jx = x;
+    return true;
+}
+
+// Neighbours worth jumping to, given the direction we arrived from
+int JumpPointSearch::prunedNeighbours(int x, int y, int dx, int dy, int* nx, int* ny) const {
+    const OccupancyGrid& g = *grid;
+    int n = 0;
+    auto add = [&](int ax, int ay) { nx[n] = ax; ny[n] = ay; ++n; };
+
+    if (dx == 0 && dy == 0) {
+        // Start node: every free neighbour, diagonals only without corner cutting
+        for (int sy = -1; sy <= 1; ++sy) {
+            for (int sx = -1; sx <= 1; ++sx) {
+                if ((sx == 0 && sy == 0) || !g.test(x + sx, y + sy)) continue;
+                if (sx != 0 && sy != 0 && (!g.test(x + sx, y) || !g.test(x, y + sy))) continue;
+                add(x + sx, y + sy);
+            }
+        }
+    } else if (dx != 0 && dy != 0) {
+        bool walkY = g.test(x, y + dy);
+        bool walkX = g.test(x + dx, y);
+        if (walkY) add(x, y + dy);
+        if (walkX) add(x + dx, y);
+        if (walkX && walkY) add(x + dx, y + dy);
+    } else if (dx != 0) {
+        bool next = g.test(x + dx, y);
+        bool down = g.test(x, y + 1);
+        bool up = g.test(x, y - 1);
+        if (next) {
+            add(x + dx, y);
+            if (down) add(x + dx, y + 1);
+            if (up) add(x + dx, y - 1);
+        }
+        if (down) add(x, y + 1);
+        if (up) add(x, y - 1);
+    } else {
+        bool next = g.test(x, y + dy);
+        bool right = g.test(x + 1, y);
+        bool left = g.test(x - 1, y);
+        if (next) {
+            add(x, y + dy);
+            if (right) add(x + 1, y + dy);
+            if (left) add(x - 1, y + dy);
+        }
+        if (right) add(x + 1, y);
+        if (left) add(x - 1, y);
+    }
+    return n;
+}
+
+std::vector<Tile> JumpPointSearch::findPath(Tile start, Tile goal, const OccupancyGrid& coarseGrid) {
+    int cols = coarseGrid.getCols();
+    int rows = coarseGrid.getRows();
+    auto inb = [&](int x, int y) { return x >= 0 && x < cols && y >= 0 && y < rows; };
+
+    int sx = start.first, sy = start.second;
+    goalX = goal.first;
+    goalY = goal.second;
+    expanded = 0;
+
+    if (!inb(sx, sy) || !inb(goalX, goalY) || !coarseGrid.test(sx, sy) || !coarseGrid.test(goalX, goalY))
+        return {};
+
+    grid = &coarseGrid;
+    ws.begin(size_t(cols) * rows);
+    open.clear();
+
+    auto worse = [](const Node& a, const Node& b) {
+        return a.f != b.f ? a.f > b.f : a.g < b.g;
+    };
+
+    int startIdx = sy * cols + sx;
+    int goalIdx = goalY * cols + goalX;
+    ws.reach(startIdx, 0, startIdx);
+    open.push_back({gridHeuristic(start, goal, Connectivity::Eight), 0, startIdx});
+    bool found = false;
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), worse);
+        Node cur = open.back();
+        open.pop_back();
+        if (ws.closed(cur.idx) || cur.g != ws.cost[cur.idx]) continue;
+        ws.close(cur.idx);
+        ++expanded;
+        if (cur.idx == goalIdx) { found = true; break; }
+
+        int x = cur.idx % cols, y = cur.idx / cols;
+        int p = ws.parent[cur.idx];
+        int dx = sign(x - p % cols), dy = sign(y - p / cols);
+
+        int nx[8], ny[8];
+        int n = prunedNeighbours(x, y, dx, dy, nx, ny);
+        for (int k = 0; k < n; ++k) {
+            int jx, jy;
+            if (!jump(nx[k], ny[k], nx[k] - x, ny[k] - y, jx, jy)) continue;
+
+            int ji = jy * cols + jx;
+            int ng = cur.g + gridHeuristic({x, y}, {jx, jy}, Connectivity::Eight);
+            if (ws.closed(ji) || (ws.reached(ji) && ws.cost[ji] <= ng)) continue;
+            ws.reach(ji, ng, cur.idx);
+            open.push_back({ng + gridHeuristic({jx, jy}, goal, Connectivity::Eight), ng, ji});
+            std::push_heap(open.begin(), open.end(), worse);
+        }
+    }
+
+    if (!found) return {};
+
+    // Jump points are joined by straight or diagonal runs; walk each run
+    std::vector<Tile> path;
+    for (int i = goalIdx; i != startIdx; i = ws.parent[i]) {
+        int x = i % cols, y = i / cols;
+        int p = ws.parent[i];
+        int px = p % cols, py = p / cols;
+        int stepX = sign(px - x), stepY = sign(py - y);
+        while (x != px || y != py) {
+            path.emplace_back(x, y);
+            if (x != px) x += stepX;
+            if (y != py) y += stepY;
+        }
+    }
+    path.emplace_back(sx, sy);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<Tile> findPathJPS(
+    Tile start,
+    Tile goal,
+    const OccupancyGrid& coarseGrid
+) {
+    JumpPointSearch jps;
+    return jps.findPath(start, goal, coarseGrid);
+}
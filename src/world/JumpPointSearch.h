@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include "world/AStar.h"
+#include "world/OccupancyGrid.h"
+#include "world/Pathfinding.h"
+#include "world/SearchWorkspace.h"
+
+// Jump Point Search on the 8-connected coarse grid (no corner cutting).
+// Only jump points are pushed to the open list; straight runs along a row
+// are scanned a 64-bit word at a time on the bit-packed grid. The returned
+// path is expanded back to one tile per step.
+class JumpPointSearch {
+public:
+    std::vector<Tile> findPath(Tile start, Tile goal, const OccupancyGrid& coarseGrid);
+
+    // Jump points expanded by the last query
+    size_t lastExpanded() const;
+
+private:
+    struct Node {
+        int f, g, idx;
+    };
+
+    SearchWorkspace ws;
+    std::vector<Node> open;
+    size_t expanded = 0;
+
+    const OccupancyGrid* grid = nullptr;
+    int goalX = 0, goalY = 0;
+
+    bool jump(int x, int y, int dx, int dy, int& jx, int& jy) const;
+    bool jumpHorizontal(int x, int y, int dx, int& jx) const;
+    bool jumpVertical(int x, int y, int dy, int& jy) const;
+    int prunedNeighbours(int x, int y, int dx, int dy, int* nx, int* ny) const;
+};
+
+// Same interface as findPathBFS, using a throwaway workspace
+std::vector<Tile> findPathJPS(
+    Tile start,
+    Tile goal,
+    const OccupancyGrid& coarseGrid
+);
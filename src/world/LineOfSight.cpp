@@ -0,0 +1,46 @@
+#include "world/LineOfSight.h"
+#include <cmath>
+#include <cstdlib>
+
+bool hasLineOfSight(const OccupancyGrid& walls, int tileSize, sf::Vector2f a, sf::Vector2f b) {
+    float ts = float(tileSize);
+    float ax = a.x / ts, ay = a.y / ts, bx = b.x / ts, by = b.y / ts;
+    int x = int(std::floor(ax)), y = int(std::floor(ay));
+    int n = std::abs(int(std::floor(bx)) - x) + std::abs(int(std::floor(by)) - y);
+
+    // Cells off the map are open
+    auto blocked = [&](int cx, int cy) {
+        return cx >= 0 && cy >= 0 && cx < walls.getCols() && cy < walls.getRows() && walls.test(cx, cy);
+    };
+    if (blocked(x, y)) return false;
+
+    // Distance, in units of the whole segment, to the next vertical or
+    // horizontal grid line and between two such lines
+    float dx = bx - ax, dy = by - ay;
+    int sx = dx > 0 ? 1 : -1, sy = dy > 0 ? 1 : -1;
+    float tDeltaX = dx != 0 ? std::fabs(1.f / dx) : INFINITY;
+    float tDeltaY = dy != 0 ? std::fabs(1.f / dy) : INFINITY;
+    float tMaxX = dx > 0 ? (x + 1 - ax) * tDeltaX : dx < 0 ? (ax - x) * tDeltaX : INFINITY;
+    float tMaxY = dy > 0 ? (y + 1 - ay) * tDeltaY : dy < 0 ? (ay - y) * tDeltaY : INFINITY;
+
+    for (int i = 0; i < n; ++i) {
+        if (tMaxX < tMaxY) {
+            x += sx;
+            tMaxX += tDeltaX;
+        } else if (tMaxY < tMaxX) {
+            y += sy;
+            tMaxY += tDeltaY;
+        } else {
+            // Exactly through a grid corner: only a diagonal pair of walls
+            // closes it, the gap between them has no width
+            if (blocked(x + sx, y) && blocked(x, y + sy)) return false;
+            x += sx;
+            y += sy;
+            tMaxX += tDeltaX;
+            tMaxY += tDeltaY;
+            ++i;
+        }
+        if (blocked(x, y)) return false;
+    }
+    return true;
+}
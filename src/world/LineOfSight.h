@@ -0,0 +1,9 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "world/OccupancyGrid.h"
+
+// True if the segment a-b crosses no wall cell. Walks the cells under the
+// segment with Amanatides-Woo DDA and stops at the first wall, so the
+// cost is O(|b - a| / tileSize) whatever the number of walls.
+// walls: true = cell overlaps a wall, tileSize px per cell
+bool hasLineOfSight(const OccupancyGrid& walls, int tileSize, sf::Vector2f a, sf::Vector2f b);
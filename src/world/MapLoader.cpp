@@ -1,5 +1,9 @@
 // MapLoader.cpp
 #include "world/MapLoader.hpp"
+#include "world/BakedMap.h"
+#include "world/RectMerge.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 // Helper for empty-vector return
@@ -16,8 +20,12 @@ MapLoader::MapLoader(const std::string& mapPath,
 {
 }
 
-bool MapLoader::load()
+MapLoader::~MapLoader() = default;
+
+bool MapLoader::load(bool loadTileset)
 {
+    baked.reset();
+
     tson::Tileson parser;
     std::unique_ptr<tson::Map> map = parser.parse(mapFile);
     if (map->getStatus() != tson::ParseStatus::OK) {
@@ -25,7 +33,7 @@ bool MapLoader::load()
         return false;
     }
 
-    if (!tilesetTexture.loadFromFile(tilesetFile)) {
+    if (loadTileset && !tilesetTexture.loadFromFile(tilesetFile)) {
         std::cerr << "Failed to load tileset: " << tilesetFile << "\n";
         return false;
     }
@@ -40,54 +48,98 @@ bool MapLoader::load()
     int columns = tileset.getColumns();
     auto& tiles = layer->getTileObjects();
 
-    vertices.setPrimitiveType(sf::Quads);
-    vertices.resize(tiles.size() * 4);
+    // What a tileset tile means, worked out the first time its id shows up:
+    // the "type" property is a string lookup, far too slow to repeat per cell
+    struct TileInfo {
+        int tu, tv;                             // texture cell
+        bool collision;
+        std::vector<sf::FloatRect>* taskList;   // nullptr = no task type
+    };
+    std::unordered_map<int, TileInfo> infoById;
+
+    // Only cells that hold a tile get a quad
+    std::vector<sf::Vertex> quads;
+    quads.reserve(tiles.size() * 4);
 
-    int idx = 0;
     for (auto& tileObj : tiles) {
         tson::TileObject& tile = tileObj.second;
         if (!tile.getTile()) continue;
 
+        int id = tile.getTile()->getId();
+        auto it = infoById.find(id);
+        if (it == infoById.end()) {
+            // Read the custom "type" property (empty if missing)
+            std::string type = tile.getTile()
+                ->getProperties()
+                .getValue<std::string>("type");
+
+            TileInfo info{id % columns, id / columns, type == "coll", nullptr};
+            if (!info.collision && !type.empty())
+                info.taskList = &taskRects[type];   // map nodes never move
+            it = infoById.emplace(id, info).first;
+        }
+        const TileInfo& info = it->second;
+
         // World position
         tson::Vector2i gridPos = tile.getPositionInTileUnits();
         float x = float(gridPos.x * tileW);
         float y = float(gridPos.y * tileH);
 
-        // Texture coords indices
-        int id = tile.getTile()->getId();
-        int tu = id % columns;
-        int tv = id / columns;
-
-        sf::Vertex* quad = &vertices[idx * 4];
-        quad[0].position = { x,          y };
-        quad[1].position = { x + tileW,  y };
-        quad[2].position = { x + tileW,  y + tileH };
-        quad[3].position = { x,          y + tileH };
-
-        // **Updated**: use sf::Vector2f ctor to avoid narrowing
-        quad[0].texCoords = sf::Vector2f(tu * tileW,      tv * tileH);
-        quad[1].texCoords = sf::Vector2f((tu + 1) * tileW, tv * tileH);
-        quad[2].texCoords = sf::Vector2f((tu + 1) * tileW, (tv + 1) * tileH);
-        quad[3].texCoords = sf::Vector2f(tu * tileW,      (tv + 1) * tileH);
-
-        // Read the custom "type" property (empty if missing)
-        std::string type = tile.getTile()
-            ->getProperties()
-            .getValue<std::string>("type");
-
-        if (type == "coll") {
+        float u0 = float(info.tu * tileW), v0 = float(info.tv * tileH);
+        float u1 = u0 + tileW, v1 = v0 + tileH;
+        quads.emplace_back(sf::Vector2f(x,         y),         sf::Vector2f(u0, v0));
+        quads.emplace_back(sf::Vector2f(x + tileW, y),         sf::Vector2f(u1, v0));
+        quads.emplace_back(sf::Vector2f(x + tileW, y + tileH), sf::Vector2f(u1, v1));
+        quads.emplace_back(sf::Vector2f(x,         y + tileH), sf::Vector2f(u0, v1));
+
+        if (info.collision) {
             collisionRects.emplace_back(x, y, float(tileW), float(tileH));
         }
-        else if (!type.empty()) {
-            taskRects[type].emplace_back(x, y, float(tileW), float(tileH));
+        else if (info.taskList) {
+            info.taskList->emplace_back(x, y, float(tileW), float(tileH));
         }
+    }
+
+    buildChunks(quads.data(), quads.size(), loadTileset);
+    return true;
+}
+
+bool MapLoader::loadBaked(const std::string& bakedPath, bool loadTileset)
+{
+    std::unique_ptr<BakedMap> file(new BakedMap);
+    if (!file->open(bakedPath, tileW, tileH, mapFile))
+        return false;
 
-        ++idx;
+    if (loadTileset && !tilesetTexture.loadFromFile(tilesetFile)) {
+        std::cerr << "Failed to load tileset: " << tilesetFile << "\n";
+        return false;
     }
 
+    auto quads = file->vertices();
+    buildChunks(quads.begin(), quads.size(), loadTileset);
+
+    auto coll = file->collisionRects();
+    collisionRects.assign(coll.begin(), coll.end());
+    taskRects.clear();
+    for (const std::string& type : file->taskTypes()) {
+        auto rects = file->taskRects(type);
+        taskRects[type].assign(rects.begin(), rects.end());
+    }
+
+    baked = std::move(file);
     return true;
 }
 
+const BakedMap* MapLoader::getBaked() const
+{
+    return baked.get();
+}
+
+void MapLoader::mergeCollisionRects()
+{
+    collisionRects = mergeTileRects(collisionRects, tileW, tileH);
+}
+
 const std::vector<sf::FloatRect>&
 MapLoader::getCollisionRects() const
 {
@@ -101,10 +153,91 @@ MapLoader::getTaskRects(const std::string& type) const
     return (it != taskRects.end() ? it->second : EMPTY_RECTS);
 }
 
+const std::unordered_map<std::string, std::vector<sf::FloatRect>>&
+MapLoader::getAllTaskRects() const
+{
+    return taskRects;
+}
+
+const std::vector<sf::Vertex>&
+MapLoader::getVertices() const
+{
+    return chunkVertices;
+}
+
+void MapLoader::buildChunks(const sf::Vertex* quads, size_t vertexCount, bool upload)
+{
+    // Map extent from the quads themselves
+    float maxX = 0.f, maxY = 0.f;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        maxX = std::max(maxX, quads[i].position.x);
+        maxY = std::max(maxY, quads[i].position.y);
+    }
+    float chunkW = float(CHUNK_TILES * tileW), chunkH = float(CHUNK_TILES * tileH);
+    chunkCols = std::max(1, int(std::ceil(maxX / chunkW)));
+    chunkRows = std::max(1, int(std::ceil(maxY / chunkH)));
+
+    // Counting sort of the quads by the chunk holding their top-left corner
+    auto chunkOf = [&](const sf::Vertex* quad) {
+        int cx = std::min(chunkCols - 1, int(quad->position.x / chunkW));
+        int cy = std::min(chunkRows - 1, int(quad->position.y / chunkH));
+        return cy * chunkCols + cx;
+    };
+    chunks.clear();
+    chunks.resize(size_t(chunkCols) * chunkRows);
+    for (size_t i = 0; i + 4 <= vertexCount; i += 4)
+        chunks[chunkOf(&quads[i])].count += 4;
+    size_t first = 0;
+    for (auto& c : chunks) {
+        c.first = first;
+        first += c.count;
+    }
+
+    chunkVertices.resize(first);
+    std::vector<size_t> fill(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) fill[i] = chunks[i].first;
+    for (size_t i = 0; i + 4 <= vertexCount; i += 4) {
+        size_t& at = fill[chunkOf(&quads[i])];
+        std::copy(quads + i, quads + i + 4, chunkVertices.begin() + at);
+        at += 4;
+    }
+
+    if (!upload || !sf::VertexBuffer::isAvailable()) return;
+    for (auto& c : chunks) {
+        if (c.count == 0) continue;
+        c.buffer.setPrimitiveType(sf::Quads);
+        c.buffer.setUsage(sf::VertexBuffer::Static);
+        if (c.buffer.create(c.count))
+            c.buffer.update(&chunkVertices[c.first]);
+    }
+}
+
 void MapLoader::draw(sf::RenderTarget& target,
                      sf::RenderStates states) const
 {
     states.transform *= getTransform();
     states.texture   = &tilesetTexture;
-    target.draw(vertices, states);
+    if (chunks.empty()) return;
+
+    // World-space box around the view (rotation included), back into map space
+    const sf::View& view = target.getView();
+    sf::FloatRect visible = view.getInverseTransform().transformRect({-1.f, -1.f, 2.f, 2.f});
+    visible = states.transform.getInverse().transformRect(visible);
+
+    float chunkW = float(CHUNK_TILES * tileW), chunkH = float(CHUNK_TILES * tileH);
+    int cx0 = std::max(0, int(std::floor(visible.left / chunkW)));
+    int cy0 = std::max(0, int(std::floor(visible.top / chunkH)));
+    int cx1 = std::min(chunkCols - 1, int(std::floor((visible.left + visible.width) / chunkW)));
+    int cy1 = std::min(chunkRows - 1, int(std::floor((visible.top + visible.height) / chunkH)));
+
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            const Chunk& c = chunks[cy * chunkCols + cx];
+            if (c.count == 0) continue;
+            if (c.buffer.getVertexCount() > 0)
+                target.draw(c.buffer, states);
+            else
+                target.draw(&chunkVertices[c.first], c.count, sf::Quads, states);
+        }
+    }
 }
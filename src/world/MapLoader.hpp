@@ -5,23 +5,48 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <memory>
 #include "tileson/include/tileson.hpp"
 
+class BakedMap;
+
 class MapLoader : public sf::Drawable, public sf::Transformable {
 public:
     MapLoader(const std::string& mapPath,
               const std::string& tilesetPath,
               int tileWidth,
               int tileHeight);
+    ~MapLoader();
+
+    // loadTileset = false skips the texture and the GPU tile buffers, so no
+    // GL context is needed (headless runs only want the collision and task rects)
+    bool load(bool loadTileset = true);
+
+    // Maps a file written by GradeHeistBake instead of parsing the JSON.
+    // Fails, leaving the loader empty, if it is missing, stale or invalid.
+    bool loadBaked(const std::string& bakedPath, bool loadTileset = true);
 
-    bool load();
+    // The mapped bake after a successful loadBaked(), else nullptr
+    const BakedMap* getBaked() const;
 
-    // Collision-only tiles (type == "coll")
+    // Optional pass after loading: merges the per-tile collision rects into
+    // maximal rectangles covering the same cells, so every wall consumer
+    // handles far fewer of them. Merging merged rects returns them unchanged.
+    void mergeCollisionRects();
+
+    // Collision-only tiles (type == "coll"), one rect per tile unless merged
     const std::vector<sf::FloatRect>& getCollisionRects() const;
 
     // Any other custom tile-type (e.g. "cout", "wifioff", etc.)
     const std::vector<sf::FloatRect>& getTaskRects(const std::string& type) const;
 
+    // Every task type with its rects, for baking
+    const std::unordered_map<std::string, std::vector<sf::FloatRect>>& getAllTaskRects() const;
+
+    // Tile quads, four vertices per tile, grouped by chunk
+    const std::vector<sf::Vertex>& getVertices() const;
+
+    // Draws only the chunks that overlap the target's current view
     virtual void draw(sf::RenderTarget& target,
                       sf::RenderStates states) const override;
 
@@ -31,11 +56,25 @@ private:
     int tileW, tileH;
 
     sf::Texture tilesetTexture;
-    sf::VertexArray vertices;
+
+    // The map is cut into CHUNK_TILES x CHUNK_TILES blocks of tiles, each
+    // drawn from its own static vertex buffer when the GPU supports them
+    static const int CHUNK_TILES = 32;
+    struct Chunk {
+        size_t first = 0, count = 0;    // vertex range in chunkVertices
+        sf::VertexBuffer buffer;
+    };
+    int chunkCols = 0, chunkRows = 0;
+    std::vector<sf::Vertex> chunkVertices;
+    std::vector<Chunk> chunks;
+
+    void buildChunks(const sf::Vertex* quads, size_t vertexCount, bool upload);
 
     // Rects for collision tiles
     std::vector<sf::FloatRect> collisionRects;
 
     // Rects for all other tile-types keyed by their "type" property
     std::unordered_map<std::string, std::vector<sf::FloatRect>> taskRects;
+
+    std::unique_ptr<BakedMap> baked;
 };
@@ -0,0 +1,146 @@
+#include "world/OccupancyGrid.h"
+#include <algorithm>
+#include <bitset>
+
+static int popcount64(uint64_t w) {
+    return int(std::bitset<64>(w).count());
+}
+
+// Mask of bits [lo, hi) within one word
+static uint64_t bitRange(int lo, int hi) {
+    uint64_t upper = hi >= 64 ? ~uint64_t(0) : ((uint64_t(1) << hi) - 1);
+    uint64_t lower = (uint64_t(1) << lo) - 1;
+    return upper & ~lower;
+}
+
+OccupancyGrid::OccupancyGrid()
+    : cols(0), rows(0), stride(2), words(2 * stride, 0)
+{
+}
+
+OccupancyGrid::OccupancyGrid(int c, int r, bool value)
+    : cols(c), rows(r), stride((c + 2 * PAD_BITS + 63) / 64), words(size_t(r + 2) * stride, 0)
+{
+    if (value) fill(true);
+}
+
+OccupancyGrid::OccupancyGrid(int c, int r, const uint64_t* data)
+    : cols(c), rows(r), stride((c + 2 * PAD_BITS + 63) / 64), words(data, data + size_t(r + 2) * stride)
+{
+}
+
+void OccupancyGrid::set(int x, int y, bool value) {
+    int b = x + PAD_BITS;
+    uint64_t bit = uint64_t(1) << (b & 63);
+    if (value) row(y)[b >> 6] |= bit;
+    else       row(y)[b >> 6] &= ~bit;
+}
+
+void OccupancyGrid::fill(bool value) {
+    for (int y = 0; y < rows; ++y) {
+        uint64_t* r = row(y);
+        for (int i = 1; i < stride - 1; ++i)
+            r[i] = value ? ~uint64_t(0) : 0;
+    }
+    clearTail();
+}
+
+void OccupancyGrid::andRow(int y, const uint64_t* other) {
+    uint64_t* r = row(y);
+    for (int i = 0; i < stride; ++i)
+        r[i] &= other[i];
+}
+
+size_t OccupancyGrid::count() const {
+    size_t n = 0;
+    for (int y = 0; y < rows; ++y) {
+        const uint64_t* r = row(y);
+        for (int i = 1; i < stride - 1; ++i)
+            n += popcount64(r[i]);
+    }
+    return n;
+}
+
+size_t OccupancyGrid::countRegion(int x, int y, int w, int h) const {
+    int x0 = std::max(0, x), x1 = std::min(cols, x + w);
+    int y0 = std::max(0, y), y1 = std::min(rows, y + h);
+    if (x0 >= x1 || y0 >= y1) return 0;
+
+    int b0 = x0 + PAD_BITS, b1 = x1 + PAD_BITS;
+    int w0 = b0 >> 6, w1 = (b1 - 1) >> 6;
+    size_t n = 0;
+    for (int yy = y0; yy < y1; ++yy) {
+        const uint64_t* r = row(yy);
+        for (int i = w0; i <= w1; ++i) {
+            int lo = i == w0 ? (b0 & 63) : 0;
+            int hi = i == w1 ? ((b1 - 1) & 63) + 1 : 64;
+            n += popcount64(r[i] & bitRange(lo, hi));
+        }
+    }
+    return n;
+}
+
+OccupancyGrid OccupancyGrid::inverted() const {
+    OccupancyGrid out(cols, rows);
+    for (int y = 0; y < rows; ++y) {
+        const uint64_t* src = row(y);
+        uint64_t* dst = out.row(y);
+        for (int i = 1; i < stride - 1; ++i)
+            dst[i] = ~src[i];
+    }
+    out.clearTail();
+    return out;
+}
+
+OccupancyGrid OccupancyGrid::eroded(int size) const {
+    size = std::max(1, size);
+    OccupancyGrid out(std::max(0, cols - size + 1), std::max(0, rows - size + 1));
+    if (out.cols == 0 || out.rows == 0) return out;
+
+    // Horizontal pass: after folding, bit x is set only if bits x..x+size-1
+    // all were. The window grows by shifted ANDs of whole rows (k -> k+s with
+    // s <= k keeps it contiguous), so this takes log2(size) sweeps. Bits past
+    // the last column are zero, which clears anchors whose box would overhang.
+    std::vector<uint64_t> horiz(size_t(rows) * stride, 0);
+    for (int y = 0; y < rows; ++y) {
+        const uint64_t* src = row(y);
+        uint64_t* h = &horiz[size_t(y) * stride];
+        std::copy(src, src + stride, h);
+        for (int k = 1; k < size; ) {
+            int s = std::min({k, size - k, 63});
+            for (int i = 0; i < stride; ++i) {
+                uint64_t hi = i + 1 < stride ? h[i + 1] : 0;
+                h[i] &= (h[i] >> s) | (hi << (64 - s));
+            }
+            k += s;
+        }
+    }
+
+    // Vertical pass: AND size consecutive horizontal rows
+    for (int y = 0; y < out.rows; ++y) {
+        uint64_t* dst = out.row(y);
+        const uint64_t* h = &horiz[size_t(y) * stride];
+        std::copy(h, h + out.stride, dst);
+        for (int dy = 1; dy < size; ++dy)
+            out.andRow(y, &horiz[size_t(y + dy) * stride]);
+    }
+    out.clearTail();
+    return out;
+}
+
+bool OccupancyGrid::operator==(const OccupancyGrid& o) const {
+    return cols == o.cols && rows == o.rows && words == o.words;
+}
+
+void OccupancyGrid::clearTail() {
+    int endBit = cols + PAD_BITS;
+    for (int y = 0; y < rows; ++y) {
+        uint64_t* r = row(y);
+        r[0] = 0;
+        for (int i = 1; i < stride; ++i) {
+            int lo = i * 64;
+            if (lo >= endBit) r[i] = 0;
+            else if (lo + 64 > endBit) r[i] &= bitRange(0, endBit - lo);
+        }
+    }
+}
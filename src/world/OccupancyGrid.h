@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bit-packed 2D grid. Rows are stored as 64-bit words with a zero word of
+// padding on both sides and a zero row above and below, so reading one
+// cell past any border needs no bounds check and always yields false.
+class OccupancyGrid {
+public:
+    static constexpr int PAD_BITS = 64;
+
+    OccupancyGrid();
+    OccupancyGrid(int cols, int rows, bool value = false);
+    // Copy of wordCount() words laid out as data() returns them
+    OccupancyGrid(int cols, int rows, const uint64_t* data);
+
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+    // Words per row, padding included
+    int getStride() const { return stride; }
+
+    // Valid for -1 <= x <= cols and -1 <= y <= rows; padding reads false
+    bool test(int x, int y) const {
+        int b = x + PAD_BITS;
+        return (row(y)[b >> 6] >> (b & 63)) & 1u;
+    }
+    bool operator()(int x, int y) const { return test(x, y); }
+    void set(int x, int y, bool value = true);
+    void fill(bool value);
+
+    // Row words including the padding words; y may be -1 or rows
+    const uint64_t* row(int y) const { return &words[size_t(y + 1) * stride]; }
+    uint64_t* row(int y) { return &words[size_t(y + 1) * stride]; }
+    // Every word, padding rows included, for writing the grid out whole
+    const uint64_t* data() const { return words.data(); }
+    size_t wordCount() const { return words.size(); }
+
+    // Word-parallel helpers
+    void andRow(int y, const uint64_t* other);                  // row(y) &= other, stride words
+    size_t count() const;                                       // set cells in the whole grid
+    size_t countRegion(int x, int y, int w, int h) const;       // set cells in a box
+    OccupancyGrid inverted() const;                             // complement inside the grid, padding stays clear
+    // Bit (x,y) of the result is set iff the size*size box at (x,y) is fully set.
+    // The result is (cols-size+1) x (rows-size+1).
+    OccupancyGrid eroded(int size) const;
+
+    bool operator==(const OccupancyGrid& o) const;
+    bool operator!=(const OccupancyGrid& o) const { return !(*this == o); }
+
+private:
+    int cols, rows, stride;
+    std::vector<uint64_t> words;
+
+    void clearTail();   // zero the bits past the last column in every row
+};
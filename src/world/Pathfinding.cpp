@@ -6,17 +6,17 @@
 std::vector<Tile> findPathBFS(
     Tile start,
     Tile goal,
-    const std::vector<bool>& coarseGrid,
-    int colsCoarse,
-    int rowsCoarse
+    const OccupancyGrid& coarseGrid
 ) {
+    int colsCoarse = coarseGrid.getCols();
+    int rowsCoarse = coarseGrid.getRows();
     auto inb = [&](int x, int y) { return x >= 0 && x < colsCoarse && y >= 0 && y < rowsCoarse; };
     auto idx = [&](int x, int y) { return y * colsCoarse + x; };
 
     int sx = start.first, sy = start.second;
     int gx = goal.first, gy = goal.second;
 
-    if (!inb(sx, sy) || !inb(gx, gy) || !coarseGrid[idx(sx, sy)] || !coarseGrid[idx(gx, gy)])
+    if (!inb(sx, sy) || !inb(gx, gy) || !coarseGrid.test(sx, sy) || !coarseGrid.test(gx, gy))
         return {};
 
     std::queue<Tile> q;
@@ -34,7 +34,8 @@ std::vector<Tile> findPathBFS(
 
         for (int d = 0; d < 4; ++d) {
             int nx = x + DX[d], ny = y + DY[d];
-            if (inb(nx, ny) && parent[idx(nx, ny)] < 0 && coarseGrid[idx(nx, ny)]) {
+            // Padding cells read as blocked, so no bounds check is needed here
+            if (coarseGrid.test(nx, ny) && parent[idx(nx, ny)] < 0) {
                 parent[idx(nx, ny)] = idx(x, y);
                 q.push({nx, ny});
             }
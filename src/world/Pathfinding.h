@@ -1,13 +1,12 @@
 #pragma once
 #include <vector>
 #include <utility> // for std::pair
+#include "world/OccupancyGrid.h"
 
 using Tile = std::pair<int, int>;
 
 std::vector<Tile> findPathBFS(
     Tile start,
     Tile goal,
-    const std::vector<bool>& coarseGrid,
-    int colsCoarse,
-    int rowsCoarse
-);
\ No newline at end of file
+    const OccupancyGrid& coarseGrid
+);
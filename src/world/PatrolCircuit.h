@@ -3,6 +3,7 @@
 #include <vector>
 #include <SFML/Graphics.hpp>
 #include "core/Constants.h"
+#include "core/CollisionIndex.h"
 
 // Returns the default patrol circuit points for the enemy's patrol path
 inline std::vector<Vec2f> getRawPatrolCircuit() {
@@ -25,8 +26,8 @@ inline std::vector<Vec2f> getRawPatrolCircuit() {
 inline std::vector<Vec2f> filterPatrolCircuit(
     const std::vector<Vec2f>& rawCircuit,
     float enemySize,
-    const std::vector<sf::RectangleShape>& walls,
-    bool (*checkCollision)(const sf::FloatRect&, const std::vector<sf::RectangleShape>&)
+    const CollisionIndex& walls,
+    bool (*checkCollision)(const sf::FloatRect&, const CollisionIndex&)
 ) {
     std::vector<Vec2f> circuit;
     for (const auto& p : rawCircuit) {
@@ -0,0 +1,165 @@
+#include "world/PatrolRouteCache.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+// Unreachable legs are stored as this marker so they are not replanned
+static const std::string UNREACHABLE = "!";
+static const char* FILE_MAGIC = "GHROUTES";
+static const int FILE_VERSION = 1;
+
+// Direction letters indexed by (dy+1)*3 + (dx+1); 's' (no move) is unused
+static const char DIR_CHARS[9] = {'q', 'w', 'e', 'a', 's', 'd', 'z', 'x', 'c'};
+
+static bool dirOf(char c, int& dx, int& dy) {
+    for (int i = 0; i < 9; ++i) {
+        if (DIR_CHARS[i] == c && i != 4) {
+            dx = i % 3 - 1;
+            dy = i / 3 - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+// FNV-1a over the grid words, so a cache built for another map is ignored
+static uint64_t hashGrid(const OccupancyGrid& g) {
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](uint64_t v) {
+        for (int b = 0; b < 8; ++b) {
+            h ^= (v >> (b * 8)) & 0xff;
+            h *= 1099511628211ull;
+        }
+    };
+    mix(uint64_t(g.getCols()));
+    mix(uint64_t(g.getRows()));
+    for (int y = 0; y < g.getRows(); ++y) {
+        const uint64_t* r = g.row(y);
+        for (int i = 0; i < g.getStride(); ++i)
+            mix(r[i]);
+    }
+    return h;
+}
+
+PatrolRouteCache::PatrolRouteCache(const std::vector<Tile>& patrolT, const OccupancyGrid& G)
+    : patrolTiles(patrolT), coarseGrid(G),
+      legs(patrolT.size()), planned(patrolT.size(), false), gridHash(hashGrid(G))
+{
+}
+
+void PatrolRouteCache::precomputeAll() {
+    for (size_t i = 0; i < legs.size(); ++i)
+        if (!planned[i]) planLeg(i);
+}
+
+std::vector<Tile> PatrolRouteCache::leg(size_t i) {
+    if (legs.empty()) return {};
+    i %= legs.size();
+    if (!planned[i]) planLeg(i);
+    if (legs[i] == UNREACHABLE) return {};
+    return decode(patrolTiles[i], legs[i]);
+}
+
+size_t PatrolRouteCache::legCount() const {
+    return legs.size();
+}
+
+void PatrolRouteCache::planLeg(size_t i) {
+    Tile from = patrolTiles[i];
+    Tile to = patrolTiles[(i + 1) % patrolTiles.size()];
+    auto path = search.findPath(from, to, coarseGrid);
+    legs[i] = path.empty() ? UNREACHABLE : encode(path);
+    planned[i] = true;
+}
+
+std::string PatrolRouteCache::encode(const std::vector<Tile>& path) {
+    std::string runs;
+    char last = 0;
+    int count = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        int dx = path[i].first - path[i - 1].first;
+        int dy = path[i].second - path[i - 1].second;
+        char c = DIR_CHARS[(dy + 1) * 3 + (dx + 1)];
+        if (c == last) {
+            ++count;
+            continue;
+        }
+        if (count > 0) runs += last + std::to_string(count);
+        last = c;
+        count = 1;
+    }
+    if (count > 0) runs += last + std::to_string(count);
+    return runs;
+}
+
+std::vector<Tile> PatrolRouteCache::decode(Tile start, const std::string& runs) {
+    std::vector<Tile> path{start};
+    size_t i = 0;
+    while (i < runs.size()) {
+        int dx, dy;
+        if (!dirOf(runs[i], dx, dy)) return {};
+        size_t end = i + 1;
+        while (end < runs.size() && runs[end] >= '0' && runs[end] <= '9') ++end;
+        int count = std::atoi(runs.substr(i + 1, end - i - 1).c_str());
+        for (int k = 0; k < count; ++k) {
+            Tile t = path.back();
+            path.emplace_back(t.first + dx, t.second + dy);
+        }
+        i = end;
+    }
+    return path;
+}
+
+// Layout: magic/version line, grid hash and sizes, the patrol tiles, then
+// one line per leg ('.' for an empty leg, '!' for unreachable)
+bool PatrolRouteCache::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to write patrol route cache: " << path << "\n";
+        return false;
+    }
+    out << FILE_MAGIC << " " << FILE_VERSION << "\n";
+    out << std::hex << gridHash << std::dec << " " << coarseGrid.getCols() << " "
+        << coarseGrid.getRows() << " " << patrolTiles.size() << "\n";
+    for (auto& t : patrolTiles)
+        out << t.first << " " << t.second << "\n";
+    for (size_t i = 0; i < legs.size(); ++i) {
+        if (!planned[i]) out << "?\n";
+        else out << (legs[i].empty() ? "." : legs[i]) << "\n";
+    }
+    return bool(out);
+}
+
+bool PatrolRouteCache::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string magic;
+    int version = 0;
+    uint64_t hash = 0;
+    int cols = 0, rows = 0;
+    size_t count = 0;
+    in >> magic >> version >> std::hex >> hash >> std::dec >> cols >> rows >> count;
+    if (!in || magic != FILE_MAGIC || version != FILE_VERSION || hash != gridHash ||
+        cols != coarseGrid.getCols() || rows != coarseGrid.getRows() || count != patrolTiles.size())
+        return false;
+
+    for (auto& t : patrolTiles) {
+        Tile f;
+        in >> f.first >> f.second;
+        if (!in || f != t) return false;
+    }
+
+    std::vector<std::string> loaded(count);
+    std::vector<bool> loadedPlanned(count, false);
+    for (size_t i = 0; i < count; ++i) {
+        std::string s;
+        if (!(in >> s)) return false;
+        if (s == "?") continue;
+        loaded[i] = s == "." ? std::string() : s;
+        loadedPlanned[i] = true;
+    }
+    legs = std::move(loaded);
+    planned = std::move(loadedPlanned);
+    return true;
+}
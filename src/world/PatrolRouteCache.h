@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "world/AStar.h"
+#include "world/OccupancyGrid.h"
+#include "world/Pathfinding.h"
+
+// Every leg of the patrol circuit, planned once and kept as a
+// run-length-encoded direction string. Leg i runs from patrolTiles[i] to
+// patrolTiles[(i+1) % n]. Steps are letters laid out like the keys around
+// 's' on a keyboard (w up, x down, a left, d right, q/e/z/c diagonals),
+// each followed by its repeat count, e.g. "d12x3".
+//
+// Legs are always planned with 4-connected A*, whatever PathMode the guard
+// uses, so every mode patrols the same circuit and one cache file serves
+// them all. The mode only plans chases and the way back to the circuit.
+class PatrolRouteCache {
+public:
+    PatrolRouteCache(const std::vector<Tile>& patrolTiles, const OccupancyGrid& coarseGrid);
+
+    // Plan every leg now instead of on first use
+    void precomputeAll();
+
+    // Leg i as tiles, planned on first use. Empty if the target is unreachable.
+    std::vector<Tile> leg(size_t i);
+    size_t legCount() const;
+
+    // Text cache next to the map; load rejects files built for another grid or circuit
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    static std::string encode(const std::vector<Tile>& path);
+    static std::vector<Tile> decode(Tile start, const std::string& runs);
+
+private:
+    std::vector<Tile> patrolTiles;
+    const OccupancyGrid& coarseGrid;
+    AStar search;
+
+    std::vector<std::string> legs;
+    std::vector<bool> planned;
+    uint64_t gridHash;
+
+    void planLeg(size_t i);
+};
@@ -0,0 +1,68 @@
+#include "world/RectMerge.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include "world/OccupancyGrid.h"
+
+std::vector<sf::FloatRect> mergeTileRects(const std::vector<sf::FloatRect>& rects, int tileW, int tileH) {
+    std::vector<sf::FloatRect> out;
+    float tw = float(tileW), th = float(tileH);
+
+    // Tile boxes of the aligned rects (whole tiles on the tile grid, single
+    // tiles or already merged); anything else is kept as is
+    struct Box { int x, y, w, h; };
+    std::vector<Box> boxes;
+    boxes.reserve(rects.size());
+    int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+    for (auto& r : rects) {
+        float fx = r.left / tw, fy = r.top / th, fw = r.width / tw, fh = r.height / th;
+        if (fw < 1.f || fh < 1.f || fx != std::floor(fx) || fy != std::floor(fy) ||
+            fw != std::floor(fw) || fh != std::floor(fh)) {
+            out.push_back(r);
+            continue;
+        }
+        Box b{int(fx), int(fy), int(fw), int(fh)};
+        boxes.push_back(b);
+        minX = std::min(minX, b.x);
+        minY = std::min(minY, b.y);
+        maxX = std::max(maxX, b.x + b.w - 1);
+        maxY = std::max(maxY, b.y + b.h - 1);
+    }
+    if (boxes.empty()) return out;
+
+    int cols = maxX - minX + 1, rows = maxY - minY + 1;
+    OccupancyGrid cells(cols, rows);
+    for (auto& b : boxes)
+        for (int y = b.y; y < b.y + b.h; ++y)
+            for (int x = b.x; x < b.x + b.w; ++x)
+                cells.set(x - minX, y - minY);
+
+    // Rects built so far, in tiles; runOpen[x0] is the rect whose run started
+    // at column x0 in the row above, if it is still open
+    struct Run { int x0, x1, y0, y1; };     // x1, y1 inclusive
+    std::vector<Run> runs;
+    std::vector<int> runOpen(cols, -1);
+    for (int y = 0; y < rows; ++y) {
+        int x = 0;
+        while (x < cols) {
+            if (!cells.test(x, y)) { ++x; continue; }
+            int x0 = x;
+            while (cells.test(x, y)) ++x;       // padding past the last column reads false
+            int x1 = x - 1;
+
+            int open = runOpen[x0];
+            if (open >= 0 && runs[open].y1 == y - 1 && runs[open].x1 == x1) {
+                runs[open].y1 = y;
+            } else {
+                runOpen[x0] = int(runs.size());
+                runs.push_back({x0, x1, y, y});
+            }
+        }
+    }
+
+    out.reserve(out.size() + runs.size());
+    for (auto& r : runs)
+        out.emplace_back(float((minX + r.x0) * tileW), float((minY + r.y0) * tileH),
+                         float((r.x1 - r.x0 + 1) * tileW), float((r.y1 - r.y0 + 1) * tileH));
+    return out;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+// Greedy merge of tile-aligned rects into fewer, larger rects covering the
+// same cells: each row is cut into maximal horizontal runs, then runs with
+// the same span in consecutive rows are stacked into one rect. The result
+// depends only on the cells covered, so merging a merged set returns it
+// unchanged. Rects not aligned to the tile grid are passed through as they
+// are, ahead of the merged ones, which are ordered by top edge, then left edge.
+std::vector<sf::FloatRect> mergeTileRects(const std::vector<sf::FloatRect>& rects, int tileW, int tileH);
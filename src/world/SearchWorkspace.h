@@ -0,0 +1,42 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Per-cell scratch state reused across grid searches. A cell's entries
+// are only valid while its stamp matches the current generation, so
+// starting a new search is O(1) instead of clearing cols*rows entries.
+struct SearchWorkspace {
+    std::vector<uint32_t> openStamp;     // generation the cell was last reached in
+    std::vector<uint32_t> closedStamp;   // generation the cell was last expanded in
+    std::vector<int> cost;               // best known g, valid when reached
+    std::vector<int> parent;             // predecessor cell index, valid when reached
+    uint32_t generation = 0;
+
+    // Start a new search over a grid of the given cell count
+    void begin(size_t cells) {
+        if (openStamp.size() != cells) {
+            openStamp.assign(cells, 0);
+            closedStamp.assign(cells, 0);
+            cost.resize(cells);
+            parent.resize(cells);
+            generation = 0;
+        }
+        if (++generation == 0) {
+            // Wrapped after 2^32 searches: reset once and carry on
+            std::fill(openStamp.begin(), openStamp.end(), 0);
+            std::fill(closedStamp.begin(), closedStamp.end(), 0);
+            generation = 1;
+        }
+    }
+
+    bool reached(int i) const { return openStamp[i] == generation; }
+    bool closed(int i) const { return closedStamp[i] == generation; }
+
+    void reach(int i, int g, int p) {
+        openStamp[i] = generation;
+        cost[i] = g;
+        parent[i] = p;
+    }
+    void close(int i) { closedStamp[i] = generation; }
+};
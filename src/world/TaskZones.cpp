@@ -0,0 +1,55 @@
+#include "world/TaskZones.h"
+#include <algorithm>
+#include <cmath>
+#include "world/RectMerge.h"
+
+TaskZoneIndex::TaskZoneIndex(int worldW, int worldH, int ts)
+    : tileSize(ts), cols(std::max(1, worldW / ts)), rows(std::max(1, worldH / ts)),
+      zoneAt(size_t(cols) * rows, -1)
+{
+}
+
+void TaskZoneIndex::add(int task, const std::vector<sf::FloatRect>& tiles) {
+    for (auto& r : mergeTileRects(tiles, tileSize, tileSize)) {
+        int id = int(zones.size());
+        zones.push_back({r, task});
+
+        int x0, y0, x1, y1;
+        tileRange(r, x0, y0, x1, y1);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                int& at = zoneAt[y * cols + x];
+                if (at < 0 || zones[at].task > task)
+                    at = id;
+            }
+        }
+    }
+}
+
+int TaskZoneIndex::find(const sf::FloatRect& b) const {
+    int x0, y0, x1, y1;
+    tileRange(b, x0, y0, x1, y1);
+    int best = -1;
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            int id = zoneAt[y * cols + x];
+            if (id >= 0 && (best < 0 || zones[id].task < best))
+                best = zones[id].task;
+        }
+    }
+    return best;
+}
+
+const std::vector<TaskZoneIndex::Zone>& TaskZoneIndex::getZones() const {
+    return zones;
+}
+
+// First tile whose right edge lies past b.left, last tile whose left edge
+// lies before b.right: exactly the tiles sf::FloatRect::intersects would hit
+void TaskZoneIndex::tileRange(const sf::FloatRect& b, int& x0, int& y0, int& x1, int& y1) const {
+    float ts = float(tileSize);
+    x0 = std::max(0, int(std::floor(b.left / ts)));
+    y0 = std::max(0, int(std::floor(b.top / ts)));
+    x1 = std::min(cols - 1, int(std::ceil((b.left + b.width) / ts)) - 1);
+    y1 = std::min(rows - 1, int(std::ceil((b.top + b.height) / ts)) - 1);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+// Which task trigger the player stands on. The per-tile trigger rects of
+// each task are merged into zones, and every tile of the world records
+// the zone covering it, so a lookup reads only the tiles under the query
+// box however many triggers the map has.
+class TaskZoneIndex {
+public:
+    struct Zone {
+        sf::FloatRect rect;
+        int task;
+    };
+
+    TaskZoneIndex(int worldW, int worldH, int tileSize);
+
+    // tiles: whole-tile trigger rects, as MapLoader::getTaskRects returns them.
+    // Where zones of two tasks claim a tile, the lower task id keeps it.
+    void add(int task, const std::vector<sf::FloatRect>& tiles);
+
+    // Lowest task whose zone overlaps b (same test as sf::FloatRect::intersects), -1 if none
+    int find(const sf::FloatRect& b) const;
+
+    const std::vector<Zone>& getZones() const;
+
+private:
+    int tileSize;
+    int cols, rows;
+    std::vector<Zone> zones;
+    std::vector<int> zoneAt;    // zone id per tile, row-major; -1 = no trigger
+
+    // Tiles b overlaps, clamped to the world; empty when x1 < x0 or y1 < y0
+    void tileRange(const sf::FloatRect& b, int& x0, int& y0, int& x1, int& y1) const;
+};
@@ -0,0 +1,285 @@
+#include "world/VisibilityCaster.h"
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+static sf::FloatRect segmentBounds(const WallSegment& s) {
+    float left = std::min(s.a.x, s.b.x), top = std::min(s.a.y, s.b.y);
+    return { left, top, std::max(s.a.x, s.b.x) - left, std::max(s.a.y, s.b.y) - top };
+}
+
+// Sweep angles are measured from this direction. It is slightly off the
+// axes so grid corners rarely sit exactly on the seam.
+static const float SWEEP_START = 3.14159265f - 0.0123f;
+static const float TWO_PI = 2 * 3.14159265f;
+
+static float cross(const sf::Vector2f& u, const sf::Vector2f& v) {
+    return u.x * v.y - u.y * v.x;
+}
+
+// Angle of p around o in [0, 2pi), counted from SWEEP_START
+static float sweepAngle(const sf::Vector2f& o, const sf::Vector2f& p) {
+    float a = std::atan2(p.y - o.y, p.x - o.x) - SWEEP_START;
+    while (a < 0.f) a += TWO_PI;
+    while (a >= TWO_PI) a -= TWO_PI;
+    return a;
+}
+
+namespace {
+
+// An edge as seen from the light: p0 -> p1 runs counter-clockwise and
+// covers sweep angles [f0, f1] without wrapping past the seam
+struct Piece {
+    sf::Vector2f p0, p1;
+    float f0, f1;
+};
+
+struct Event {
+    float angle;
+    bool begin;
+    int piece;
+};
+
+// Point of piece p on the ray at sweep angle f
+sf::Vector2f hitAt(const Piece& p, const sf::Vector2f& o, float f) {
+    if (f == p.f0) return p.p0;
+    if (f == p.f1) return p.p1;
+    sf::Vector2f d(std::cos(f + SWEEP_START), std::sin(f + SWEEP_START));
+    sf::Vector2f e = p.p1 - p.p0;
+    float den = cross(d, e);
+    if (std::fabs(den) < 1e-9f) return p.p0;
+    float t = cross(p.p0 - o, e) / den;
+    return o + d * t;
+}
+
+// Orders active pieces by distance from the light. Edges never cross, so
+// two pieces keep the same order over their whole common angle range and
+// can be compared in the middle of it.
+struct NearerThan {
+    const std::vector<Piece>* pieces;
+    sf::Vector2f o;
+
+    bool operator()(int a, int b) const {
+        if (a == b) return false;
+        const Piece& A = (*pieces)[a];
+        const Piece& B = (*pieces)[b];
+        float mid = (std::max(A.f0, B.f0) + std::min(A.f1, B.f1)) / 2;
+        sf::Vector2f ha = hitAt(A, o, mid) - o, hb = hitAt(B, o, mid) - o;
+        float da = ha.x * ha.x + ha.y * ha.y, db = hb.x * hb.x + hb.y * hb.y;
+        if (da != db) return da < db;
+        return a < b;
+    }
+};
+
+// Adds edge a-b, oriented and split at the seam, to pieces
+void addPiece(std::vector<Piece>& pieces, const sf::Vector2f& o, sf::Vector2f a, sf::Vector2f b) {
+    float c = cross(a - o, b - o);
+    if (std::fabs(c) < 1e-4f) return;   // edge-on to the light, hides nothing
+    if (c < 0) std::swap(a, b);
+    float fa = sweepAngle(o, a), fb = sweepAngle(o, b);
+    if (fb > fa) {
+        pieces.push_back({a, b, fa, fb});
+    } else if (fb == 0.f) {
+        pieces.push_back({a, b, fa, TWO_PI});
+    } else {
+        // Straddles the seam: split where the start ray crosses it
+        sf::Vector2f d(std::cos(SWEEP_START), std::sin(SWEEP_START));
+        sf::Vector2f e = b - a;
+        float t = cross(a - o, e) / cross(d, e);
+        sf::Vector2f s = o + d * t;
+        pieces.push_back({a, s, fa, TWO_PI});
+        pieces.push_back({s, b, 0.f, fb});
+    }
+}
+
+}
+
+VisibilityCaster::VisibilityCaster(const OccupancyGrid& G, int tileSize, int cs)
+    : cellSize(cs),
+      cols(std::max(1, G.getCols() * tileSize / cs)),
+      rows(std::max(1, G.getRows() * tileSize / cs))
+{
+    int gc = G.getCols(), gr = G.getRows();
+    float ts = float(tileSize);
+
+    // Horizontal edges: on line y, walk x and extend the run while the
+    // cells above and below differ. Padding reads open, so the map border
+    // gets edges too. Runs also end where a vertical edge passes straight
+    // through (diagonal wall corners), so no two segments ever cross.
+    for (int y = 0; y <= gr; ++y) {
+        int start = -1;
+        for (int x = 0; x <= gc; ++x) {
+            bool edge = x < gc && G.test(x, y - 1) != G.test(x, y);
+            bool crossed = G.test(x - 1, y - 1) != G.test(x, y - 1) && G.test(x - 1, y) != G.test(x, y);
+            if (start >= 0 && (!edge || crossed)) {
+                segments.push_back({ {start * ts, y * ts}, {x * ts, y * ts} });
+                start = -1;
+            }
+            if (edge && start < 0) start = x;
+        }
+    }
+    // Vertical edges, the same walk with the axes swapped
+    for (int x = 0; x <= gc; ++x) {
+        int start = -1;
+        for (int y = 0; y <= gr; ++y) {
+            bool edge = y < gr && G.test(x - 1, y) != G.test(x, y);
+            bool crossed = G.test(x - 1, y - 1) != G.test(x - 1, y) && G.test(x, y - 1) != G.test(x, y);
+            if (start >= 0 && (!edge || crossed)) {
+                segments.push_back({ {x * ts, start * ts}, {x * ts, y * ts} });
+                start = -1;
+            }
+            if (edge && start < 0) start = y;
+        }
+    }
+
+    // Pass 1: count entries per cell, pass 2: scatter ids into place
+    cellStart.assign(cols * rows + 1, 0);
+    for (auto& s : segments) {
+        int x0, y0, x1, y1;
+        cellRange(segmentBounds(s), x0, y0, x1, y1);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                ++cellStart[y * cols + x + 1];
+    }
+    for (size_t i = 1; i < cellStart.size(); ++i)
+        cellStart[i] += cellStart[i - 1];
+
+    cellItems.resize(cellStart.back());
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int id = 0; id < int(segments.size()); ++id) {
+        int x0, y0, x1, y1;
+        cellRange(segmentBounds(segments[id]), x0, y0, x1, y1);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                cellItems[fill[y * cols + x]++] = id;
+    }
+}
+
+void VisibilityCaster::query(const sf::FloatRect& box, std::vector<int>& out) const {
+    out.clear();
+    int x0, y0, x1, y1;
+    cellRange(box, x0, y0, x1, y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            int c = y * cols + x;
+            for (int i = cellStart[c]; i < cellStart[c + 1]; ++i) {
+                sf::FloatRect b = segmentBounds(segments[cellItems[i]]);
+                // Inclusive test: segments are zero-width along one axis
+                if (b.left <= box.left + box.width && box.left <= b.left + b.width &&
+                    b.top <= box.top + box.height && box.top <= b.top + b.height)
+                    out.push_back(cellItems[i]);
+            }
+        }
+    }
+    // Long merged edges sit in several cells
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+VisibilityPolygon VisibilityCaster::visibility(const sf::Vector2f& o, float radius, int sides) const {
+    VisibilityPolygon poly;
+    poly.origin = o;
+
+    // Bounding polygon of the light, as edges the sweep cannot see past
+    std::vector<sf::Vector2f> ring(sides);
+    for (int i = 0; i < sides; ++i) {
+        float a = TWO_PI * i / sides;
+        ring[i] = o + sf::Vector2f(std::cos(a), std::sin(a)) * radius;
+    }
+    std::vector<Piece> pieces;
+    for (int i = 0; i < sides; ++i)
+        addPiece(pieces, o, ring[i], ring[(i + 1) % sides]);
+
+    // Nearby walls, clipped to the bounding polygon so nothing crosses it
+    std::vector<int> nearby;
+    query({o.x - radius, o.y - radius, 2 * radius, 2 * radius}, nearby);
+    float apothem = radius * std::cos(TWO_PI / (2 * sides));
+    for (int id : nearby) {
+        sf::Vector2f a = segments[id].a - o, e = segments[id].b - segments[id].a;
+        float tIn = 0.f, tOut = 1.f;
+        for (int i = 0; i < sides && tIn < tOut; ++i) {
+            float m = TWO_PI * (i + 0.5f) / sides;
+            sf::Vector2f n(std::cos(m), std::sin(m));
+            // Inside this side while dot(n, a + t*e) <= apothem
+            float c = apothem - (n.x * a.x + n.y * a.y), k = n.x * e.x + n.y * e.y;
+            if (k == 0.f) {
+                if (c < 0.f) tOut = -1.f;
+            } else if (k > 0.f) {
+                tOut = std::min(tOut, c / k);
+            } else {
+                tIn = std::max(tIn, c / k);
+            }
+        }
+        if (tIn < tOut)
+            addPiece(pieces, o, segments[id].a + e * tIn, segments[id].a + e * tOut);
+    }
+
+    // Ends sort before begins at the same angle, so pieces meeting at a
+    // corner are never active together
+    std::vector<Event> events;
+    events.reserve(pieces.size() * 2);
+    for (int i = 0; i < int(pieces.size()); ++i) {
+        events.push_back({pieces[i].f0, true, i});
+        events.push_back({pieces[i].f1, false, i});
+    }
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        if (a.angle != b.angle) return a.angle < b.angle;
+        return !a.begin && b.begin;
+    });
+
+    std::set<int, NearerThan> active(NearerThan{&pieces, o});
+    std::vector<std::set<int, NearerThan>::iterator> where(pieces.size(), active.end());
+    auto emit = [&](const sf::Vector2f& p) {
+        if (!poly.points.empty()) {
+            sf::Vector2f d = p - poly.points.back();
+            if (d.x * d.x + d.y * d.y < 1e-6f) return;
+        }
+        poly.points.push_back(p);
+    };
+
+    for (size_t i = 0; i < events.size();) {
+        float f = events[i].angle;
+        int before = active.empty() ? -1 : *active.begin();
+        for (; i < events.size() && events[i].angle == f; ++i) {
+            int id = events[i].piece;
+            if (events[i].begin) where[id] = active.insert(id).first;
+            else active.erase(where[id]);
+        }
+        int after = active.empty() ? -1 : *active.begin();
+        // The nearest edge changed: the outline jumps along this ray
+        if (before != after) {
+            if (before >= 0) emit(hitAt(pieces[before], o, f));
+            if (after >= 0) emit(hitAt(pieces[after], o, f));
+        }
+    }
+    if (poly.points.size() > 1) {
+        sf::Vector2f d = poly.points.back() - poly.points.front();
+        if (d.x * d.x + d.y * d.y < 1e-6f) poly.points.pop_back();
+    }
+    return poly;
+}
+
+// Crossing-number test against the outline
+bool VisibilityPolygon::contains(const sf::Vector2f& p) const {
+    bool inside = false;
+    for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+        const sf::Vector2f& a = points[i];
+        const sf::Vector2f& b = points[j];
+        if ((a.y > p.y) != (b.y > p.y) &&
+            p.x < a.x + (p.y - a.y) * (b.x - a.x) / (b.y - a.y))
+            inside = !inside;
+    }
+    return inside;
+}
+
+const std::vector<WallSegment>& VisibilityCaster::getSegments() const {
+    return segments;
+}
+
+// Cells covered by b, clamped to the grid like CollisionIndex::cellRange
+void VisibilityCaster::cellRange(const sf::FloatRect& b, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = std::clamp(int(std::floor(b.left / cellSize)), 0, cols - 1);
+    y0 = std::clamp(int(std::floor(b.top / cellSize)), 0, rows - 1);
+    x1 = std::clamp(int(std::floor((b.left + b.width) / cellSize)), 0, cols - 1);
+    y1 = std::clamp(int(std::floor((b.top + b.height) / cellSize)), 0, rows - 1);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "world/OccupancyGrid.h"
+
+struct WallSegment {
+    sf::Vector2f a, b;
+};
+
+// Region lit by one light: a star-shaped polygon around origin, with
+// points in counter-clockwise order
+struct VisibilityPolygon {
+    sf::Vector2f origin;
+    std::vector<sf::Vector2f> points;
+
+    bool contains(const sf::Vector2f& p) const;
+};
+
+// Outer edges of the wall geometry for the guard light. Edges are taken
+// from the walkable grid once at map load, where a wall cell borders an
+// open one, and collinear neighbours are merged into a single segment.
+// Segments are bucketed in a uniform grid so a cast only touches the
+// edges near the light, not every wall on the map.
+class VisibilityCaster {
+public:
+    // walls: true = cell overlaps a wall, tileSize px per cell
+    VisibilityCaster(const OccupancyGrid& walls, int tileSize, int cellSize);
+
+    // Ids of the segments whose bounds touch box, each listed once
+    void query(const sf::FloatRect& box, std::vector<int>& out) const;
+
+    // Exact region visible from origin within a regular `sides`-gon of
+    // circumradius `radius`. Angular sweep over the nearby edges with an
+    // ordered active-edge set, O(n log n) in the edges near the light.
+    VisibilityPolygon visibility(const sf::Vector2f& origin, float radius, int sides = 32) const;
+
+    const std::vector<WallSegment>& getSegments() const;
+
+private:
+    int cellSize;
+    int cols, rows;
+    std::vector<WallSegment> segments;
+
+    // Same CSR layout as CollisionIndex: segment ids of cell i live in
+    // cellItems[cellStart[i] .. cellStart[i+1])
+    std::vector<int> cellStart;
+    std::vector<int> cellItems;
+
+    void cellRange(const sf::FloatRect& b, int& x0, int& y0, int& x1, int& y1) const;
+};
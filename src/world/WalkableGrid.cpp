@@ -1,19 +1,26 @@
 #include "world/WalkableGrid.h"
+#include <algorithm>
+#include <cmath>
 
-std::vector<bool> buildWalkableGrid(const std::vector<sf::RectangleShape>& walls, int worldW, int worldH, int tileSize) {
+// Rasterizes each wall straight into the cells it covers, so the cost is
+// O(walls + cells) instead of testing every cell against every wall.
+// A cell is marked exactly when sf::FloatRect::intersects would report an
+// overlap, i.e. the open intervals overlap on both axes.
+OccupancyGrid buildWalkableGrid(const std::vector<sf::FloatRect>& walls, int worldW, int worldH, int tileSize) {
     int cols = worldW / tileSize;
     int rows = worldH / tileSize;
-    std::vector<bool> grid(cols * rows);
-    for (int y = 0; y < rows; ++y) {
-        for (int x = 0; x < cols; ++x) {
-            sf::FloatRect cell(x * tileSize, y * tileSize, tileSize, tileSize);
-            for (auto& w : walls) {
-                if (cell.intersects(w.getGlobalBounds())) {
-                    grid[y*cols + x] = true;
-                    break;
-                }
-            }
-        }
+    OccupancyGrid grid(cols, rows);
+    float ts = float(tileSize);
+    for (auto& w : walls) {
+        if (w.width <= 0.f || w.height <= 0.f) continue;
+        // First cell whose right edge lies past w.left, last cell whose left edge lies before w.right
+        int x0 = std::max(0, int(std::floor(w.left / ts)));
+        int y0 = std::max(0, int(std::floor(w.top / ts)));
+        int x1 = std::min(cols - 1, int(std::ceil((w.left + w.width) / ts)) - 1);
+        int y1 = std::min(rows - 1, int(std::ceil((w.top + w.height) / ts)) - 1);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                grid.set(x, y);
     }
     return grid;
 }
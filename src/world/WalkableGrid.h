@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <SFML/Graphics.hpp>
+#include "world/OccupancyGrid.h"
 
-// Build walkable grid from walls
-std::vector<bool> buildWalkableGrid(const std::vector<sf::RectangleShape>& walls, int worldW, int worldH, int tileSize);
+// Build walkable grid from collision rects (true = cell overlaps a wall)
+OccupancyGrid buildWalkableGrid(const std::vector<sf::FloatRect>& walls, int worldW, int worldH, int tileSize);